@@ -25,7 +25,8 @@ AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
   : myFragmentSize(fragmentSize),
     myIsStereo(isStereo),
     myFragmentQueue(capacity),
-    myAllFragments(capacity + 2)
+    myAllFragments(capacity + 2),
+    myTelemetry(capacity)
 {
   const uInt8 sampleSize = myIsStereo ? 2 : 1;
 
@@ -92,7 +93,10 @@ Int16* AudioQueue::enqueue(Int16* fragment)
   if (mySize < capacity) ++mySize;
   else {
     myNextFragment = (myNextFragment + 1) % capacity;
-    if (!myIgnoreOverflows) myOverflowLogger.log();
+    if (!myIgnoreOverflows) {
+      myOverflowLogger.log();
+      myTelemetry.recordOverflow();
+    }
   }
 
   return newFragment;
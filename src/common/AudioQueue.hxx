@@ -22,6 +22,7 @@
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
+#include "AudioTelemetry.hxx"
 
 /**
   This class implements a an audio queue that acts both like a ring buffer
@@ -96,6 +97,11 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      Telemetry for the audio pipeline fed by this queue.
+     */
+    AudioTelemetry& telemetry() { return myTelemetry; }
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -132,6 +138,9 @@ class AudioQueue
 
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
+    // Pipeline statistics (disabled by default)
+    AudioTelemetry myTelemetry;
+
   private:
 
     AudioQueue() = delete;
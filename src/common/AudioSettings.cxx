@@ -94,6 +94,9 @@ void AudioSettings::normalize(Settings& settings)
 
   int settingVolume = settings.getInt(SETTING_VOLUME);
   if (settingVolume < 0 || settingVolume > 100) settings.setValue(SETTING_VOLUME, DEFAULT_VOLUME);
+
+  int settingDynamicRate = settings.getInt(SETTING_DYNAMIC_RATE);
+  if (settingDynamicRate < 0 || settingDynamicRate > MAX_DYNAMIC_RATE) settings.setValue(SETTING_DYNAMIC_RATE, DEFAULT_DYNAMIC_RATE);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -166,6 +169,19 @@ uInt32 AudioSettings::dpcPitch() const
   return lboundInt(mySettings.getInt(SETTING_DPC_PITCH), 10000);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AudioSettings::telemetry() const
+{
+  return mySettings.getBool(SETTING_TELEMETRY);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioSettings::dynamicRate() const
+{
+  // 0 is a valid value (disabled) -> keep it
+  return std::min(lboundInt(mySettings.getInt(SETTING_DYNAMIC_RATE), 0), uInt32(MAX_DYNAMIC_RATE));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioSettings::setPreset(AudioSettings::Preset preset)
 {
@@ -50,6 +50,8 @@ class AudioSettings
     static constexpr const char* SETTING_VOLUME              = "audio.volume";
     static constexpr const char* SETTING_ENABLED             = "audio.enabled";
     static constexpr const char* SETTING_DPC_PITCH           = "audio.dpc_pitch";
+    static constexpr const char* SETTING_TELEMETRY           = "audio.telemetry";
+    static constexpr const char* SETTING_DYNAMIC_RATE        = "audio.dynamic_rate";
 
     static constexpr Preset DEFAULT_PRESET                          = Preset::highQualityMediumLag;
     static constexpr uInt32 DEFAULT_SAMPLE_RATE                     = 44100;
@@ -61,9 +63,12 @@ class AudioSettings
     static constexpr uInt32 DEFAULT_VOLUME                          = 80;
     static constexpr bool DEFAULT_ENABLED                           = true;
     static constexpr uInt32 DEFAULT_DPC_PITCH                       = 20000;
+    static constexpr bool DEFAULT_TELEMETRY                         = false;
+    static constexpr uInt32 DEFAULT_DYNAMIC_RATE                    = 0;
 
     static constexpr int MAX_BUFFER_SIZE = 10;
     static constexpr int MAX_HEADROOM    = 10;
+    static constexpr int MAX_DYNAMIC_RATE = 2000;
 
   public:
 
@@ -91,6 +96,10 @@ class AudioSettings
 
     uInt32 dpcPitch() const;
 
+    bool telemetry() const;
+
+    uInt32 dynamicRate() const;
+
     void setPreset(Preset preset);
 
     void setSampleRate(uInt32 sampleRate);
@@ -0,0 +1,152 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "AudioTelemetry.hxx"
+
+using namespace std::chrono;
+using std::mutex;
+using std::lock_guard;
+
+AudioTelemetry::AudioTelemetry(uInt32 queueCapacity)
+  : myQueueDepth(queueCapacity + 1, 1),
+    myLatency(LATENCY_BUCKETS, LATENCY_BUCKET_WIDTH),
+    myHistory(HISTORY_SIZE)
+{
+  reset();
+}
+
+void AudioTelemetry::setEnabled(bool enabled)
+{
+  if(enabled && !myIsEnabled) reset();
+
+  myIsEnabled = enabled;
+}
+
+void AudioTelemetry::reset()
+{
+  lock_guard<mutex> guard(myMutex);
+
+  myUnderruns.store(0, std::memory_order_relaxed);
+  myOverflows.store(0, std::memory_order_relaxed);
+  myInputSamples = myOutputSamples = 0;
+  myQueueDepth.reset();
+  myLatency.reset();
+  myHistoryNext = myHistorySize = 0;
+  myStartTime = high_resolution_clock::now();
+}
+
+void AudioTelemetry::setSinkFormat(uInt32 inputSampleRate, uInt32 fragmentSize,
+                                   uInt32 outputSampleRate, uInt32 outputBufferSize)
+{
+  lock_guard<mutex> guard(myMutex);
+
+  myInputSampleRate = inputSampleRate;
+  myFragmentSize = fragmentSize;
+  myOutputSampleRate = outputSampleRate;
+  myOutputBufferSize = outputBufferSize;
+}
+
+void AudioTelemetry::recordCallback(uInt32 queueDepth, uInt32 fragmentsConsumed,
+                                    uInt32 outputSamples, double rateAdjustment)
+{
+  if(!myIsEnabled) return;
+
+  lock_guard<mutex> guard(myMutex);
+
+  // Audio that has been emulated, but not yet been played: the queued fragments
+  // plus the buffer of the sound device
+  const double latency =
+    (myInputSampleRate ? 1000. * queueDepth * myFragmentSize / myInputSampleRate : 0) +
+    (myOutputSampleRate ? 1000. * myOutputBufferSize / myOutputSampleRate : 0);
+
+  myInputSamples += uInt64(fragmentsConsumed) * myFragmentSize;
+  myOutputSamples += outputSamples;
+
+  myQueueDepth.add(queueDepth);
+  myLatency.add(latency);
+
+  Record& record = myHistory[myHistoryNext];
+  record.time = duration_cast<duration<double>>(high_resolution_clock::now() - myStartTime).count();
+  record.queueDepth = queueDepth;
+  record.latency = latency;
+  record.inputSamples = myInputSamples;
+  record.outputSamples = myOutputSamples;
+  record.underruns = underruns();
+  record.overflows = overflows();
+  record.rateAdjustment = rateAdjustment;
+
+  myHistoryNext = (myHistoryNext + 1) % HISTORY_SIZE;
+  if(myHistorySize < HISTORY_SIZE) ++myHistorySize;
+}
+
+AudioTelemetry::Record AudioTelemetry::lastRecord()
+{
+  lock_guard<mutex> guard(myMutex);
+
+  return myHistorySize
+    ? myHistory[(myHistoryNext + HISTORY_SIZE - 1) % HISTORY_SIZE]
+    : Record();
+}
+
+double AudioTelemetry::effectiveRatio()
+{
+  lock_guard<mutex> guard(myMutex);
+
+  if(myHistorySize < 2) return 0;
+
+  const uInt32 window = myHistorySize < RATIO_WINDOW ? myHistorySize : RATIO_WINDOW;
+  const Record& last = myHistory[(myHistoryNext + HISTORY_SIZE - 1) % HISTORY_SIZE];
+  const Record& first = myHistory[(myHistoryNext + HISTORY_SIZE - window) % HISTORY_SIZE];
+  const uInt64 output = last.outputSamples - first.outputSamples;
+
+  return output ? double(last.inputSamples - first.inputSamples) / double(output) : 0;
+}
+
+double AudioTelemetry::nominalRatio() const
+{
+  return myOutputSampleRate ? double(myInputSampleRate) / double(myOutputSampleRate) : 0;
+}
+
+void AudioTelemetry::saveCSV(ostream& out)
+{
+  lock_guard<mutex> guard(myMutex);
+
+  out << "time,queue_depth,latency_ms,input_samples,output_samples,underruns,overflows,rate_adjust_ppm" << endl;
+  for(uInt32 i = 0; i < myHistorySize; ++i)
+  {
+    const Record& r = myHistory[(myHistoryNext + HISTORY_SIZE - myHistorySize + i) % HISTORY_SIZE];
+
+    out << std::fixed << std::setprecision(6) << r.time << ','
+        << r.queueDepth << ','
+        << std::setprecision(3) << r.latency << ','
+        << r.inputSamples << ','
+        << r.outputSamples << ','
+        << r.underruns << ','
+        << r.overflows << ','
+        << std::setprecision(1) << r.rateAdjustment << endl;
+  }
+
+  out << endl << "queue_depth,count" << endl;
+  for(uInt32 i = 0; i < myQueueDepth.bucketCount(); ++i)
+    out << i << ',' << myQueueDepth.bucket(i) << endl;
+
+  out << endl << "latency_ms,count" << endl;
+  for(uInt32 i = 0; i < myLatency.bucketCount(); ++i)
+    if(myLatency.bucket(i))
+      out << std::setprecision(0) << (i * myLatency.bucketWidth()) << ','
+          << myLatency.bucket(i) << endl;
+}
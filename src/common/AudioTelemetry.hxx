@@ -0,0 +1,181 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef AUDIO_TELEMETRY_HXX
+#define AUDIO_TELEMETRY_HXX
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "bspf.hxx"
+#include "Histogram.hxx"
+
+/**
+  This class collects statistics about the audio pipeline: the fill level of
+  the fragment queue, underruns of the sound driver, overflows of the queue,
+  the effective end-to-end latency, the effective resampling ratio and the
+  adjustment applied by dynamic rate control.
+
+  Overflows are reported by the emulation thread (via the AudioQueue), while
+  all other events are reported by the sound driver on its audio thread. The
+  statistics are read from the main thread (overlay, CSV export).
+
+  All recording methods are no-ops unless telemetry is enabled.
+*/
+class AudioTelemetry
+{
+  public:
+    struct Record {
+      double time{0};          // seconds since reset
+      uInt32 queueDepth{0};    // queued fragments
+      double latency{0};       // milliseconds
+      uInt64 inputSamples{0};  // total samples consumed from the queue
+      uInt64 outputSamples{0}; // total samples produced by the resampler
+      uInt32 underruns{0};     // total underruns
+      uInt32 overflows{0};     // total overflows
+      double rateAdjustment{0}; // ppm (dynamic rate control)
+    };
+
+  public:
+    /**
+      Create a new telemetry recorder.
+
+      @param queueCapacity  The capacity of the monitored queue (in fragments)
+     */
+    explicit AudioTelemetry(uInt32 queueCapacity);
+
+    /**
+      Enable / disable recording.
+     */
+    void setEnabled(bool enabled);
+    bool enabled() const { return myIsEnabled; }
+
+    /**
+      Clear all statistics.
+     */
+    void reset();
+
+    /**
+      Describe the sink. This is required for latency and ratio calculation.
+
+      @param inputSampleRate   The sample rate of the emulation (queue)
+      @param fragmentSize      The size of the queued fragments
+      @param outputSampleRate  The sample rate of the sound device
+      @param outputBufferSize  The size of the sound device buffer (in samples)
+     */
+    void setSinkFormat(uInt32 inputSampleRate, uInt32 fragmentSize,
+                       uInt32 outputSampleRate, uInt32 outputBufferSize);
+
+    /**
+      The queue overflowed (a fragment was dropped).
+     */
+    void recordOverflow() {
+      if(myIsEnabled) myOverflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+      The sink ran out of fragments.
+     */
+    void recordUnderrun() {
+      if(myIsEnabled) myUnderruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+      The sink has processed one callback.
+
+      @param queueDepth         The number of fragments left in the queue
+      @param fragmentsConsumed  The number of fragments dequeued during the callback
+      @param outputSamples      The number of (mono / stereo) samples produced
+      @param rateAdjustment     The current resampling rate adjustment (ppm)
+     */
+    void recordCallback(uInt32 queueDepth, uInt32 fragmentsConsumed, uInt32 outputSamples,
+                        double rateAdjustment = 0);
+
+    uInt32 underruns() const { return myUnderruns.load(std::memory_order_relaxed); }
+    uInt32 overflows() const { return myOverflows.load(std::memory_order_relaxed); }
+
+    const Histogram& queueDepth() const { return myQueueDepth; }
+    const Histogram& latency() const { return myLatency; }
+
+    /**
+      The most recent record.
+     */
+    Record lastRecord();
+
+    /**
+      The ratio of consumed input samples to produced output samples over the
+      last few callbacks.
+     */
+    double effectiveRatio();
+
+    /**
+      The nominal ratio of input to output sample rate.
+     */
+    double nominalRatio() const;
+
+    /**
+      Write the recorded time series and the histograms as CSV.
+     */
+    void saveCSV(ostream& out);
+
+  private:
+    // The number of records kept for export (roughly one per sound callback)
+    static constexpr uInt32 HISTORY_SIZE = 8192;
+
+    // The number of records used to calculate the effective ratio
+    static constexpr uInt32 RATIO_WINDOW = 128;
+
+    // Latency histogram resolution
+    static constexpr uInt32 LATENCY_BUCKETS = 500;
+    static constexpr double LATENCY_BUCKET_WIDTH = 1.; // ms
+
+  private:
+    std::atomic<bool> myIsEnabled{false};
+
+    uInt32 myInputSampleRate{0};
+    uInt32 myFragmentSize{0};
+    uInt32 myOutputSampleRate{0};
+    uInt32 myOutputBufferSize{0};
+
+    std::atomic<uInt32> myUnderruns{0};
+    std::atomic<uInt32> myOverflows{0};
+
+    uInt64 myInputSamples{0};
+    uInt64 myOutputSamples{0};
+
+    Histogram myQueueDepth;
+    Histogram myLatency;
+
+    // Ring buffer of records; guarded by the mutex
+    vector<Record> myHistory;
+    uInt32 myHistoryNext{0};
+    uInt32 myHistorySize{0};
+    std::mutex myMutex;
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> myStartTime;
+
+  private:
+    // Following constructors and assignment operators not supported
+    AudioTelemetry() = delete;
+    AudioTelemetry(const AudioTelemetry&) = delete;
+    AudioTelemetry(AudioTelemetry&&) = delete;
+    AudioTelemetry& operator=(const AudioTelemetry&) = delete;
+    AudioTelemetry& operator=(AudioTelemetry&&) = delete;
+};
+
+#endif // AUDIO_TELEMETRY_HXX
@@ -161,7 +161,13 @@ bool FBSurfaceSDL2::render()
 
   if(myIsVisible && myBlitter)
   {
-    myBlitter->blit(*mySurface);
+    if(myTrackDirtyRows)
+    {
+      myBlitter->blit(*mySurface, &myDirtyRows);
+      std::fill(myDirtyRows.begin(), myDirtyRows.end(), false);
+    }
+    else
+      myBlitter->blit(*mySurface, nullptr);
 
     return true;
   }
@@ -174,6 +180,23 @@ void FBSurfaceSDL2::invalidate()
   ASSERT_MAIN_THREAD;
 
   SDL_FillRect(mySurface, nullptr, 0);
+  markDirtyRows(0, mySurface->h);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::setDirtyTracking(bool enable)
+{
+  myTrackDirtyRows = enable;
+  myDirtyRows.assign(mySurface->h, true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::markDirtyRows(uInt32 y, uInt32 h)
+{
+  const uInt32 end = std::min(y + h, static_cast<uInt32>(myDirtyRows.size()));
+
+  for(; y < end; ++y)
+    myDirtyRows[y] = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -232,6 +255,8 @@ void FBSurfaceSDL2::createSurface(uInt32 width, uInt32 height,
   myPitch = mySurface->pitch / pf.BytesPerPixel;
   ////////////////////////////////////////////////////
 
+  myDirtyRows.assign(height, true);
+
   myIsStatic = data != nullptr;
   if(myIsStatic)
     SDL_memcpy(mySurface->pixels, data, mySurface->w * mySurface->h * 4);
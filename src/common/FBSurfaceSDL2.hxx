@@ -56,6 +56,8 @@ class FBSurfaceSDL2 : public FBSurface
     void translateCoords(Int32& x, Int32& y) const override;
     bool render() override;
     void invalidate() override;
+    void setDirtyTracking(bool enable) override;
+    void markDirtyRows(uInt32 y, uInt32 h) override;
     void free() override;
     void reload() override;
     void resize(uInt32 width, uInt32 height) override;
@@ -107,6 +109,10 @@ class FBSurfaceSDL2 : public FBSurface
     bool myIsVisible{true};
     bool myIsStatic{false};
 
+    // Rows modified since the last render (only used with dirty tracking)
+    bool myTrackDirtyRows{false};
+    Blitter::DirtyRows myDirtyRows;
+
     Common::Rect mySrcGUIR, myDstGUIR;
 };
 
@@ -53,6 +53,12 @@ class FilesystemNodeZIP : public AbstractFSNode
     bool isReadable() const  override { return _realNode && _realNode->isReadable(); }
     bool isWritable() const  override { return false; }
 
+    // The archive itself changes with any of its files
+    size_t getSize() const override { return _realNode ? _realNode->getSize() : 0; }
+    uInt64 getLastModified() const override {
+      return _realNode ? _realNode->getLastModified() : 0;
+    }
+
     //////////////////////////////////////////////////////////
     // For now, ZIP files cannot be modified in any way
     bool makeDir() override { return false; }
@@ -101,9 +107,6 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     bool _isDirectory{false}, _isFile{false};
 
-    // ZipHandler static reference variable responsible for accessing ZIP files
-    static unique_ptr<ZipHandler> myZipHandler;
-
     // Get last component of path
     static const char* lastPathComponent(const string& str)
     {
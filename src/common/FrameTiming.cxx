@@ -0,0 +1,179 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FrameTiming.hxx"
+
+using namespace std::chrono;
+
+namespace {
+  // Histogram resolution
+  constexpr uInt32 BUCKETS = 1000;
+  constexpr double BUCKET_WIDTH = 0.1; // ms
+
+  double elapsedMs(const FrameTiming::TimePoint& start, const FrameTiming::TimePoint& end)
+  {
+    return duration_cast<duration<double, std::milli>>(end - start).count();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameTiming::FrameTiming()
+  : myHistory(HISTORY_SIZE)
+{
+  for(auto& histogram: myHistograms)
+    histogram = make_unique<Histogram>(BUCKETS, BUCKET_WIDTH);
+
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::setEnabled(bool enabled)
+{
+  if(enabled && !myIsEnabled) reset();
+
+  myIsEnabled = enabled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::reset()
+{
+  for(auto& histogram: myHistograms)
+    histogram->reset();
+
+  myEmulationTime.store(0, std::memory_order_relaxed);
+  myCurrent = Record();
+  myHistoryNext = myHistorySize = 0;
+  myStartTime = now();
+
+  resume();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::resume()
+{
+  myPollTime = myFrameInputTime = myLastPresent = TimePoint();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::record(Metric metric, const TimePoint& start, const TimePoint& end)
+{
+  if(!myIsEnabled) return;
+
+  const double ms = elapsedMs(start, end);
+
+  myHistograms[static_cast<size_t>(metric)]->add(ms);
+
+  if(metric == Metric::emulation)
+    myEmulationTime.fetch_add(uInt64(ms * 1000), std::memory_order_relaxed);
+  else
+    myCurrent.ms[static_cast<size_t>(metric)] = ms;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::inputPolled()
+{
+  if(!myIsEnabled) return;
+
+  // The frame presented after this poll has been emulated before it, using
+  // the input of the previous poll
+  myFrameInputTime = myPollTime;
+  myPollTime = now();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::framePresented(const TimePoint& start, const TimePoint& end)
+{
+  if(!myIsEnabled) return;
+
+  record(Metric::present, start, end);
+  if(myLastPresent != TimePoint())
+    record(Metric::interval, myLastPresent, end);
+  if(myFrameInputTime != TimePoint())
+    record(Metric::latency, myFrameInputTime, end);
+
+  myLastPresent = end;
+
+  myCurrent.time = duration_cast<duration<double>>(end - myStartTime).count();
+  myCurrent.ms[static_cast<size_t>(Metric::emulation)] =
+    double(myEmulationTime.exchange(0, std::memory_order_relaxed)) / 1000;
+
+  myHistory[myHistoryNext] = myCurrent;
+  myHistoryNext = (myHistoryNext + 1) % HISTORY_SIZE;
+  if(myHistorySize < HISTORY_SIZE) ++myHistorySize;
+
+  myCurrent = Record();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string FrameTiming::name(Metric metric)
+{
+  switch(metric)
+  {
+    case Metric::emulation:  return "emulation";
+    case Metric::conversion: return "conversion";
+    case Metric::present:    return "present";
+    case Metric::interval:   return "interval";
+    case Metric::latency:    return "latency";
+    default:                 return EmptyString;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameTiming::saveCSV(ostream& out) const
+{
+  out << "time";
+  for(size_t i = 0; i < NUM_METRICS; ++i)
+    out << ',' << name(Metric(i)) << "_ms";
+  out << endl;
+
+  for(uInt32 i = 0; i < myHistorySize; ++i)
+  {
+    const Record& r = myHistory[(myHistoryNext + HISTORY_SIZE - myHistorySize + i) % HISTORY_SIZE];
+
+    out << std::fixed << std::setprecision(6) << r.time << std::setprecision(3);
+    for(double ms: r.ms)
+      out << ',' << ms;
+    out << endl;
+  }
+
+  out << endl << "metric,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms" << endl;
+  for(size_t i = 0; i < NUM_METRICS; ++i)
+  {
+    const Histogram& h = *myHistograms[i];
+
+    out << name(Metric(i)) << ',' << h.count() << ',' << std::setprecision(1)
+        << h.mean() << ',' << h.percentile(50) << ',' << h.percentile(95) << ','
+        << h.percentile(99) << ',' << h.max() << endl;
+  }
+
+  out << endl << "bucket_ms";
+  for(size_t i = 0; i < NUM_METRICS; ++i)
+    out << ',' << name(Metric(i));
+  out << endl;
+  for(uInt32 b = 0; b < BUCKETS; ++b)
+  {
+    bool empty = true;
+    for(const auto& histogram: myHistograms)
+      if(histogram->bucket(b)) empty = false;
+    if(empty) continue;
+
+    out << std::setprecision(1) << (b * BUCKET_WIDTH);
+    for(const auto& histogram: myHistograms)
+      out << ',' << histogram->bucket(b);
+    out << endl;
+  }
+}
@@ -0,0 +1,146 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef FRAME_TIMING_HXX
+#define FRAME_TIMING_HXX
+
+#include <atomic>
+#include <chrono>
+
+#include "bspf.hxx"
+#include "Histogram.hxx"
+
+/**
+  This class collects statistics about frame pacing: how long the emulation,
+  the conversion of the TIA image and the presentation (including the wait
+  for vsync) take, how regularly frames are delivered to the display and how
+  long it takes from polling the input until a frame reflecting it has been
+  presented.
+
+  Emulation times are reported by the emulation worker, all other times are
+  reported and read on the main thread.
+
+  All recording methods are no-ops unless timing is enabled.
+*/
+class FrameTiming
+{
+  public:
+    enum class Metric {
+      emulation,   // emulation of one timeslice
+      conversion,  // conversion of the TIA image into the texture
+      present,     // presentation, including the wait for vsync
+      interval,    // time between two presented frames
+      latency,     // input poll until the frame has been presented
+      NumMetrics
+    };
+
+    using Clock = std::chrono::high_resolution_clock;
+    using TimePoint = Clock::time_point;
+
+    struct Record {
+      double time{0};  // seconds since reset
+      // milliseconds per metric (emulation: accumulated since the last frame)
+      std::array<double, static_cast<size_t>(Metric::NumMetrics)> ms{0};
+    };
+
+  public:
+    FrameTiming();
+
+    /**
+      Enable / disable recording.
+     */
+    void setEnabled(bool enabled);
+    bool enabled() const { return myIsEnabled; }
+
+    /**
+      Clear all statistics.
+     */
+    void reset();
+
+    /**
+      Emulation has been resumed (e.g. after pause or a dialog). Forget the
+      previous input poll and frame, as they are not related to the next one.
+     */
+    void resume();
+
+    static TimePoint now() { return Clock::now(); }
+
+    /**
+      Record the duration of a stage.
+     */
+    void record(Metric metric, const TimePoint& start, const TimePoint& end);
+
+    /**
+      The input has been polled.
+     */
+    void inputPolled();
+
+    /**
+      A frame has been presented. This also records interval and latency.
+     */
+    void framePresented(const TimePoint& start, const TimePoint& end);
+
+    const Histogram& histogram(Metric metric) const {
+      return *myHistograms[static_cast<size_t>(metric)];
+    }
+
+    /**
+      The name of the metric (used for export).
+     */
+    static string name(Metric metric);
+
+    /**
+      Write the recorded frames, the percentiles and the histograms as CSV.
+     */
+    void saveCSV(ostream& out) const;
+
+  private:
+    // The number of frames kept for export (about one minute)
+    static constexpr uInt32 HISTORY_SIZE = 4096;
+
+    static constexpr size_t NUM_METRICS = static_cast<size_t>(Metric::NumMetrics);
+
+  private:
+    std::atomic<bool> myIsEnabled{false};
+
+    std::array<unique_ptr<Histogram>, NUM_METRICS> myHistograms;
+
+    // Emulation time since the last presented frame (microseconds)
+    std::atomic<uInt64> myEmulationTime{0};
+
+    // The stages of the frame that is currently being presented
+    Record myCurrent;
+
+    TimePoint myStartTime;
+    TimePoint myPollTime;
+    TimePoint myFrameInputTime;
+    TimePoint myLastPresent;
+
+    // Ring buffer of frames; main thread only
+    vector<Record> myHistory;
+    uInt32 myHistoryNext{0};
+    uInt32 myHistorySize{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    FrameTiming(const FrameTiming&) = delete;
+    FrameTiming(FrameTiming&&) = delete;
+    FrameTiming& operator=(const FrameTiming&) = delete;
+    FrameTiming& operator=(FrameTiming&&) = delete;
+};
+
+#endif // FRAME_TIMING_HXX
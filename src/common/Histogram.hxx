@@ -0,0 +1,155 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef HISTOGRAM_HXX
+#define HISTOGRAM_HXX
+
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+  A histogram with a fixed number of equally sized buckets. Values beyond the
+  last bucket are accumulated in the last bucket.
+
+  Values are recorded with relaxed atomics, so a single thread may record
+  while another thread reads percentiles (e.g. audio callback vs. UI). The
+  results read in this way are approximate, which is good enough for
+  statistics.
+*/
+class Histogram
+{
+  public:
+    /**
+      Create a new histogram.
+
+      @param bucketCount  The number of buckets
+      @param bucketWidth  The width of each bucket (in units of the values)
+    */
+    Histogram(uInt32 bucketCount, double bucketWidth)
+      : myBucketCount(std::max(bucketCount, 1U)),
+        myBucketWidth(bucketWidth > 0 ? bucketWidth : 1),
+        myBuckets(make_unique<std::atomic<uInt32>[]>(myBucketCount))
+    {
+      reset();
+    }
+
+    /**
+      Clear all recorded values.
+    */
+    void reset()
+    {
+      for(uInt32 i = 0; i < myBucketCount; ++i)
+        myBuckets[i].store(0, std::memory_order_relaxed);
+
+      myCount.store(0, std::memory_order_relaxed);
+      mySum.store(0, std::memory_order_relaxed);
+      myMax.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+      Record a value (negative values are recorded as zero).
+    */
+    void add(double value)
+    {
+      if(value < 0) value = 0;
+
+      const uInt32 bucket = std::min(uInt32(value / myBucketWidth), myBucketCount - 1);
+      // Sums and maxima are accumulated in 1/1000 units of the values
+      const uInt64 scaled = uInt64(value * 1000);
+
+      myBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+      myCount.fetch_add(1, std::memory_order_relaxed);
+      mySum.fetch_add(scaled, std::memory_order_relaxed);
+
+      // Values are added concurrently (e.g. emulation and audio callback),
+      // so only replace the maximum if no larger value has been stored since
+      uInt64 max = myMax.load(std::memory_order_relaxed);
+      while(scaled > max &&
+            !myMax.compare_exchange_weak(max, scaled, std::memory_order_relaxed))
+        ;
+    }
+
+    /**
+      The number of recorded values.
+    */
+    uInt64 count() const { return myCount.load(std::memory_order_relaxed); }
+
+    /**
+      The mean of all recorded values.
+    */
+    double mean() const {
+      const uInt64 n = count();
+      return n ? double(mySum.load(std::memory_order_relaxed)) / 1000 / double(n) : 0;
+    }
+
+    /**
+      The largest recorded value.
+    */
+    double max() const { return double(myMax.load(std::memory_order_relaxed)) / 1000; }
+
+    /**
+      Estimate the given percentile (0 - 100) from the buckets. The result is
+      the upper bound of the bucket that contains the percentile.
+    */
+    double percentile(double percent) const
+    {
+      const uInt64 n = count();
+      if(n == 0) return 0;
+
+      const uInt64 rank = std::max(uInt64(1), uInt64(double(n) * percent / 100. + 0.5));
+      uInt64 accumulated = 0;
+
+      for(uInt32 i = 0; i < myBucketCount; ++i)
+      {
+        accumulated += myBuckets[i].load(std::memory_order_relaxed);
+        if(accumulated >= rank)
+          return std::min(double(i + 1) * myBucketWidth, max());
+      }
+
+      return max();
+    }
+
+    /**
+      Number of buckets and their contents, for export.
+    */
+    uInt32 bucketCount() const { return myBucketCount; }
+    double bucketWidth() const { return myBucketWidth; }
+    uInt32 bucket(uInt32 i) const {
+      return i < myBucketCount ? myBuckets[i].load(std::memory_order_relaxed) : 0;
+    }
+
+  private:
+    uInt32 myBucketCount{1};
+    double myBucketWidth{1};
+
+    unique_ptr<std::atomic<uInt32>[]> myBuckets;
+
+    std::atomic<uInt64> myCount{0};
+    std::atomic<uInt64> mySum{0};
+    std::atomic<uInt64> myMax{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    Histogram() = delete;
+    Histogram(const Histogram&) = delete;
+    Histogram(Histogram&&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+    Histogram& operator=(Histogram&&) = delete;
+};
+
+#endif // HISTOGRAM_HXX
@@ -19,6 +19,7 @@
 #define LOGGER_HXX
 
 #include <functional>
+#include <mutex>
 
 #include "bspf.hxx"
 
@@ -61,6 +62,9 @@ class Logger {
     // The list of log messages
     string myLogMessages;
 
+    // Messages may also be logged by background threads
+    std::mutex myMutex;
+
   private:
     void logMessage(const string& message, Level level);
 
@@ -41,6 +41,14 @@ class PNGLibrary
   public:
     explicit PNGLibrary(OSystem& osystem);
 
+    /**
+      A decoded PNG image, as RGB triples.
+    */
+    struct Image {
+      vector<png_byte> buffer;
+      png_uint_32 width{0}, height{0}, pitch{0};
+    };
+
     /**
       Read a PNG image from the specified file into a FBSurface structure,
       scaling the image to the surface bounds.
@@ -54,6 +62,27 @@ class PNGLibrary
     */
     void loadImage(const string& filename, FBSurface& surface);
 
+    /**
+      Decode a PNG image from the specified file.  This doesn't access the
+      framebuffer, and may be called from any thread.
+
+      @param filename  The filename to load the PNG image
+      @param image     The decoded image (its buffer is reused if possible)
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    static void readImage(const string& filename, Image& image);
+
+    /**
+      Load a decoded PNG image into a FBSurface structure.  The surface
+      is resized as necessary to accommodate the data.
+
+      @param image    The decoded image
+      @param surface  The FBSurface into which to place the PNG data
+    */
+    void loadImage(const Image& image, FBSurface& surface);
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -134,28 +163,9 @@ class PNGLibrary
     uInt32 mySnapInterval{0};
     uInt32 mySnapCounter{0};
 
-    // The following data remains between invocations of allocateStorage,
-    // and is only changed when absolutely necessary.
-    struct ReadInfoType {
-      vector<png_byte> buffer;
-      vector<png_bytep> row_pointers;
-      png_uint_32 width{0}, height{0}, pitch{0};
-    };
-    static ReadInfoType ReadInfo;
-
-    /**
-      Allocate memory for PNG read operations.  This is used to provide a
-      basic memory manager, so that we don't constantly allocate and deallocate
-      memory for each image loaded.
-
-      The method fills the 'ReadInfo' struct with valid memory locations
-      dependent on the given dimensions.  If memory has been previously
-      allocated and it can accommodate the given dimensions, it is used directly.
-
-      @param iwidth  The width of the PNG image
-      @param iheight The height of the PNG image
-    */
-    bool allocateStorage(png_uint_32 iwidth, png_uint_32 iheight);
+    // The image data remains between invocations of loadImage, and is
+    // only reallocated when absolutely necessary
+    static Image ReadInfo;
 
     /** The actual method which saves a PNG image.
 
@@ -169,14 +179,6 @@ class PNGLibrary
                          png_uint_32 width, png_uint_32 height,
                          const VariantList& comments);
 
-    /**
-      Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
-      is resized as necessary to accommodate the data.
-
-      @param surface  The FBSurface into which to place the PNG data
-    */
-    void loadImagetoSurface(FBSurface& surface);
-
     /**
       Write PNG tEXt chunks to the image.
     */
@@ -15,8 +15,16 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <cmath>
+
 #include "PhosphorHandler.hxx"
 
+#if defined(BSPF_SSE2)
+  #include <emmintrin.h>
+#elif defined(BSPF_NEON)
+  #include <arm_neon.h>
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PhosphorHandler::initialize(bool enable, int blend)
 {
@@ -30,7 +38,7 @@ bool PhosphorHandler::initialize(bool enable, int blend)
   // Used to calculate an averaged color for the 'phosphor' effect
   auto getPhosphor = [&] (const uInt8 c1, uInt8 c2) -> uInt8 {
     // Use maximum of current and decayed previous values
-    c2 = static_cast<uInt8>(c2 * myPhosphorPercent);
+    c2 = static_cast<uInt8>((c2 * ourPhosphorFactor) >> 16);
     if(c1 > c2)  return c1; // raise (assumed immediate)
     else         return c2; // decay
   };
@@ -38,6 +46,10 @@ bool PhosphorHandler::initialize(bool enable, int blend)
   // Precalculate the average colors for the 'phosphor' effect
   if(myUsePhosphor)
   {
+    // The decay is calculated in fixed point, so that the vectorized blending
+    // in blendRow() produces exactly the same results as the lookup table
+    ourPhosphorFactor = static_cast<uInt32>(std::ceil(myPhosphorPercent * 0x10000));
+
     for(int c = 255; c >= 0; --c)
       for(int p = 255; p >= 0; --p)
         ourPhosphorLUT[c][p] = getPhosphor(uInt8(c), uInt8(p));
@@ -46,4 +58,76 @@ bool PhosphorHandler::initialize(bool enable, int blend)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PhosphorHandler::blendRow(const uInt32* current, uInt32* previous,
+                               uInt32* out, uInt32 count)
+{
+  uInt32 i = 0, changed = 0;
+
+#if defined(BSPF_SSE2)
+  // Four pixels at a time; each channel of the previous frame is decayed by
+  // a 16 bit multiplication, then the maximum of both frames is taken
+  const bool decay = ourPhosphorFactor < 0x10000;
+  const __m128i factor = _mm_set1_epi16(static_cast<short>(ourPhosphorFactor & 0xffff));
+  const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+  const __m128i zero = _mm_setzero_si128();
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+    const __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i));
+    __m128i p = prev;
+
+    if(decay)
+      p = _mm_packus_epi16(_mm_mulhi_epu16(_mm_unpacklo_epi8(p, zero), factor),
+                           _mm_mulhi_epu16(_mm_unpackhi_epi8(p, zero), factor));
+
+    const __m128i rgb = _mm_and_si128(_mm_max_epu8(c, p), rgbMask);
+    changed |= _mm_movemask_epi8(_mm_cmpeq_epi32(rgb, prev)) ^ 0xffff;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(previous + i), rgb);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), rgb);
+  }
+#elif defined(BSPF_NEON)
+  const bool decay = ourPhosphorFactor < 0x10000;
+  const uint16x4_t factor = vdup_n_u16(static_cast<uInt16>(ourPhosphorFactor & 0xffff));
+  const uint32x4_t rgbMask = vdupq_n_u32(0x00ffffff);
+  uint32x4_t diff = vdupq_n_u32(0);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const uint8x16_t c = vreinterpretq_u8_u32(vld1q_u32(current + i));
+    const uint32x4_t prev = vld1q_u32(previous + i);
+    uint8x16_t p = vreinterpretq_u8_u32(prev);
+
+    if(decay)
+    {
+      const uint16x8_t lo = vmovl_u8(vget_low_u8(p)), hi = vmovl_u8(vget_high_u8(p));
+      p = vcombine_u8(
+        vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(lo), factor), 16),
+                               vshrn_n_u32(vmull_u16(vget_high_u16(lo), factor), 16))),
+        vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(hi), factor), 16),
+                               vshrn_n_u32(vmull_u16(vget_high_u16(hi), factor), 16))));
+    }
+
+    const uint32x4_t rgb = vandq_u32(vreinterpretq_u32_u8(vmaxq_u8(c, p)), rgbMask);
+    diff = vorrq_u32(diff, veorq_u32(rgb, prev));
+    vst1q_u32(previous + i, rgb);
+    vst1q_u32(out + i, rgb);
+  }
+  changed = vgetq_lane_u32(diff, 0) | vgetq_lane_u32(diff, 1) |
+            vgetq_lane_u32(diff, 2) | vgetq_lane_u32(diff, 3);
+#endif
+
+  for(; i < count; ++i)
+  {
+    const uInt32 rgb = getPixel(current[i], previous[i]);
+
+    changed |= rgb ^ previous[i];
+    previous[i] = out[i] = rgb;
+  }
+
+  return changed != 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 PhosphorHandler::ourPhosphorFactor = 0x10000;
 PhosphorHandler::PhosphorLUT PhosphorHandler::ourPhosphorLUT;
@@ -52,6 +52,21 @@ class PhosphorHandler
               ourPhosphorLUT[bc][bp];
     }
 
+    /**
+      Blend a row of pixels, using vector instructions where available.
+      The result is stored in both 'previous' and 'out' (which may be the
+      same as 'current').
+
+      @param current   RGB colors of the current frame
+      @param previous  RGB colors of the previous frame (updated)
+      @param out       Destination of the averaged RGB colors
+      @param count     The number of pixels
+
+      @return  True if any pixel of 'previous' changed
+    */
+    static bool blendRow(const uInt32* current, uInt32* previous, uInt32* out,
+                         uInt32 count);
+
   private:
     // Use phosphor effect
     bool myUsePhosphor{false};
@@ -59,6 +74,9 @@ class PhosphorHandler
     // Amount to blend when using phosphor effect
     float myPhosphorPercent{0.60F};
 
+    // Decay of the previous frame, in 16.16 fixed point (0x10000 = no decay)
+    static uInt32 ourPhosphorFactor;
+
     // Precalculated averaged phosphor colors
     using PhosphorLUT = BSPF::array2D<uInt8, kColor, kColor>;
     static PhosphorLUT ourPhosphorLUT;
@@ -0,0 +1,136 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "RomCache.hxx"
+
+namespace {
+  // Each entry is stored as 'size|mtime|md5|bankswitch|left|right|format'
+  constexpr char SEPARATOR = '|';
+
+  string fileStamp(const FilesystemNode& rom)
+  {
+    ostringstream buf;
+    buf << rom.getSize() << SEPARATOR << rom.getLastModified();
+
+    return buf.str();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomCache::RomCache(shared_ptr<KeyValueRepository> repository)
+  : myRepository(repository)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomCache::Entry RomCache::get(const FilesystemNode& rom)
+{
+  Entry entry;
+
+  if(rom.getSize() == 0 || rom.getLastModified() == 0)
+    return entry;
+
+  load();
+
+  string value;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    const auto iter = myEntries.find(rom.getPath());
+    if(iter == myEntries.end())
+      return entry;
+
+    value = iter->second.toString();
+  }
+
+  std::array<string, 7> fields;
+  istringstream buf(value);
+  for(auto& field: fields)
+    getline(buf, field, SEPARATOR);
+
+  // The file has changed since it was cached
+  if(fields[0] + SEPARATOR + fields[1] != fileStamp(rom))
+    return entry;
+
+  entry.md5             = fields[2];
+  entry.bankswitch      = fields[3];
+  entry.leftController  = fields[4];
+  entry.rightController = fields[5];
+  entry.displayFormat   = fields[6];
+
+  return entry;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCache::set(const FilesystemNode& rom, const Entry& entry)
+{
+  if(rom.getSize() == 0 || rom.getLastModified() == 0 || entry.md5.empty())
+    return;
+
+  load();
+
+  const string value = fileStamp(rom) + SEPARATOR + entry.md5 + SEPARATOR +
+    entry.bankswitch + SEPARATOR + entry.leftController + SEPARATOR +
+    entry.rightController + SEPARATOR + entry.displayFormat;
+
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  Variant& stored = myEntries[rom.getPath()];
+  if(stored.toString() != value)
+  {
+    stored = value;
+    myRepository->save(rom.getPath(), stored);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCache::load()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  if(myIsLoaded) return;
+
+  myEntries = myRepository->load();
+  myIsLoaded = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCache::removeMissing()
+{
+  vector<string> paths;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    // The cache hasn't been used in this session
+    if(!myIsLoaded) return;
+
+    for(const auto& entry: myEntries)
+      paths.push_back(entry.first);
+  }
+
+  // The files are checked without holding the lock
+  for(const auto& path: paths)
+  {
+    if(!FilesystemNode(path).exists())
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+
+      myEntries.erase(path);
+      myRepository->remove(path);
+    }
+  }
+}
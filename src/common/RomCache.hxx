@@ -0,0 +1,99 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_CACHE_HXX
+#define ROM_CACHE_HXX
+
+#include <map>
+#include <mutex>
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "Variant.hxx"
+#include "repository/KeyValueRepository.hxx"
+
+/**
+  A persistent cache of the information derived from ROM files: the MD5 and
+  the results of the bankswitch, controller and frame layout autodetection.
+  Loading or browsing a ROM again can then skip reading and analyzing it.
+
+  Entries are stored by path, and are only valid as long as size and time of
+  the last modification of the file (with sub-second resolution, where the
+  filesystem provides it) are unchanged.  Files whose size or modification
+  time are unknown are not cached.
+
+  Entries may be looked up by any thread (e.g. by the ROM indexer), but are
+  only loaded and stored by the main thread, which owns the repository.
+*/
+class RomCache
+{
+  public:
+    /**
+      The cached information of a ROM; values not known yet are empty.
+      All types are stored by their property names.
+    */
+    struct Entry
+    {
+      string md5;
+      string bankswitch;       // autodetected bankswitch type
+      string leftController;   // autodetected controller for the left port
+      string rightController;  // autodetected controller for the right port
+      string displayFormat;    // autodetected frame layout
+    };
+
+  public:
+    explicit RomCache(shared_ptr<KeyValueRepository> repository);
+
+    /**
+      Get the cached information of a ROM (empty if there is none).
+    */
+    Entry get(const FilesystemNode& rom);
+
+    /**
+      Store the information of a ROM; it is only written if it changed.
+    */
+    void set(const FilesystemNode& rom, const Entry& entry);
+
+    /**
+      Load the cache, unless this happened already (on first use).
+    */
+    void load();
+
+    /**
+      Remove the entries of ROMs which no longer exist (e.g. because they
+      were renamed or deleted).  This checks each cached file, so it is
+      only done when Stella exits.
+    */
+    void removeMissing();
+
+  private:
+    shared_ptr<KeyValueRepository> myRepository;
+    std::mutex myMutex;
+
+    std::map<string, Variant> myEntries;
+    bool myIsLoaded{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomCache() = delete;
+    RomCache(const RomCache&) = delete;
+    RomCache(RomCache&&) = delete;
+    RomCache& operator=(const RomCache&) = delete;
+    RomCache& operator=(RomCache&&) = delete;
+};
+
+#endif
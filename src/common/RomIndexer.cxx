@@ -0,0 +1,253 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "Bankswitch.hxx"
+#include "CartDetector.hxx"
+#include "ControllerDetector.hxx"
+#include "MD5.hxx"
+#include "Settings.hxx"
+#include "SignatureIndex.hxx"
+#include "RomIndexer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::RomIndexer(RomCache& cache, const Settings& settings)
+  : myCache(cache),
+    mySettings(settings)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::~RomIndexer()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myWakeup.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::index(const FilesystemNode& node, bool recursive)
+{
+  if(!node.isDirectory() && !node.isFile())
+    return;
+
+  // The threads only look up entries, so the cache must be loaded here
+  myCache.load();
+
+  // The threads are only started when they are needed; one core is left to
+  // the main thread
+  if(myThreads.empty())
+  {
+    const uInt32 cores = std::thread::hardware_concurrency();
+    const uInt32 threads = cores > 2 ? cores - 1 : 1;
+
+    for(uInt32 i = 0; i < threads; ++i)
+      myThreads.emplace_back(&RomIndexer::workerLoop, this);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    if(myTasks.empty() && myActiveTasks == 0)
+      myFound = myIndexed = 0;
+
+    Task task;
+    task.node = node;
+    task.isDirectory = node.isDirectory();
+    task.recursive = recursive;
+    // The threads must not access the settings, which the main thread may
+    // change meanwhile
+    task.romInfo = mySettings.getBool("rominfo");
+    task.generation = myGeneration;
+    myTasks.push_front(task);
+
+    if(!task.isDirectory)
+    {
+      myQueued.insert(node.getPath());
+      ++myFound;
+    }
+  }
+  myWakeup.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::cancel()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Dropped ROMs may be queued again later
+  for(const auto& task: myTasks)
+    if(!task.isDirectory)
+      myQueued.erase(task.node.getPath());
+
+  myTasks.clear();
+  ++myGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::setPaused(bool paused)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    if(myIsPaused == paused)
+      return;
+
+    myIsPaused = paused;
+  }
+  myWakeup.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::update()
+{
+  vector<std::pair<FilesystemNode, RomCache::Entry>> results;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    results.swap(myResults);
+  }
+
+  for(auto& result: results)
+  {
+    // Keep the frame layout, which might have been detected meanwhile
+    const RomCache::Entry cached = myCache.get(result.first);
+    if(cached.md5 == result.second.md5)
+      result.second.displayFormat = cached.displayFormat;
+
+    myCache.set(result.first, result.second);
+  }
+
+  return !results.empty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::isBusy() const
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  return !myTasks.empty() || myActiveTasks > 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::workerLoop()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  for(;;)
+  {
+    myWakeup.wait(lock, [this]{ return myQuit || (!myIsPaused && !myTasks.empty()); });
+    if(myQuit)
+      return;
+
+    const Task task = myTasks.front();
+    myTasks.pop_front();
+    ++myActiveTasks;
+    lock.unlock();
+
+    if(task.isDirectory)
+      listDirectory(task);
+    else
+      indexRom(task.node, task.romInfo);
+
+    lock.lock();
+    --myActiveTasks;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::listDirectory(const Task& task)
+{
+  FSList files;
+  task.node.getChildren(files, task.recursive
+      ? FilesystemNode::ListMode::All : FilesystemNode::ListMode::FilesOnly,
+    [](const FilesystemNode&) { return true; }, false);
+
+  uInt32 added = 0;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    if(task.generation != myGeneration)
+      return;
+
+    for(const auto& file: files)
+    {
+      Task child;
+      child.node = file;
+      child.recursive = task.recursive;
+      child.romInfo = task.romInfo;
+      child.generation = task.generation;
+
+      if(file.isDirectory())
+      {
+        if(!task.recursive)
+          continue;
+        child.isDirectory = true;
+      }
+      else if(!file.isFile() || !Bankswitch::isValidRomName(file) ||
+              !myQueued.insert(file.getPath()).second)
+        continue;
+      else
+        ++myFound;
+
+      // Finish this directory before continuing with older ones
+      myTasks.insert(myTasks.begin() + added++, child);
+    }
+  }
+  myWakeup.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::indexRom(const FilesystemNode& rom, bool romInfo)
+{
+  RomCache::Entry entry = myCache.get(rom);
+
+  if(entry.md5 == EmptyString || entry.bankswitch == EmptyString ||
+     entry.leftController == EmptyString || entry.rightController == EmptyString)
+  {
+    try
+    {
+      ByteBuffer image;
+      const size_t size = rom.read(image);
+
+      if(size != 0)
+      {
+        const SignatureIndex index(image.get(), size);
+
+        entry.md5 = MD5::hash(image, size);
+        entry.bankswitch = Bankswitch::typeToName(CartDetector::autodetectType(index));
+        entry.leftController = Controller::getPropName(ControllerDetector::detectType(
+            index, Controller::Type::Unknown, Controller::Jack::Left, romInfo));
+        entry.rightController = Controller::getPropName(ControllerDetector::detectType(
+            index, Controller::Type::Unknown, Controller::Jack::Right, romInfo));
+
+        std::lock_guard<std::mutex> lock(myMutex);
+        myResults.emplace_back(rom, entry);
+      }
+    }
+    catch(const runtime_error&)
+    {
+      // Unreadable ROMs are simply not indexed
+    }
+  }
+
+  ++myIndexed;
+}
@@ -0,0 +1,145 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef ROM_INDEXER_HXX
+#define ROM_INDEXER_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+class Settings;
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "RomCache.hxx"
+
+/**
+  This class indexes ROM libraries in the background.  A pool of threads walks
+  the requested directories (and ZIP archives), reads the ROMs, and computes
+  their MD5 and the results of the bankswitch and controller autodetection.
+
+  The most recently requested directory is indexed first.  ROMs which are
+  already in the ROM cache, or have been indexed in this session, are skipped.
+
+  The threads never write to the cache; the results are stored by 'update',
+  which must be called regularly by the main thread.
+*/
+class RomIndexer
+{
+  public:
+    RomIndexer(RomCache& cache, const Settings& settings);
+    ~RomIndexer();
+
+    /**
+      Index the ROMs in the given directory, or the given ROM.
+
+      @param node       The directory or ROM to index
+      @param recursive  Also index all subdirectories and ZIP archives
+    */
+    void index(const FilesystemNode& node, bool recursive = false);
+
+    /**
+      Drop all directories and ROMs which have not been indexed yet.
+    */
+    void cancel();
+
+    /**
+      Pause / resume indexing (e.g. to leave the CPU to the emulation).
+    */
+    void setPaused(bool paused);
+
+    /**
+      Store the results of the indexed ROMs in the ROM cache.
+
+      @return  True if any results have been stored
+    */
+    bool update();
+
+    /**
+      Whether there are ROMs left to index.
+    */
+    bool isBusy() const;
+
+    /**
+      The number of ROMs found and the number of ROMs indexed since the
+      indexer was last idle.
+    */
+    uInt32 found() const { return myFound; }
+    uInt32 indexed() const { return myIndexed; }
+
+  private:
+    struct Task
+    {
+      FilesystemNode node;
+      bool isDirectory{false};
+      bool recursive{false};
+      bool romInfo{false};   // the 'rominfo' setting when the task was queued
+      uInt32 generation{0};  // tasks of older generations have been cancelled
+    };
+
+    void workerLoop();
+
+    /**
+      List a directory, and add its ROMs (and subdirectories) as new tasks.
+    */
+    void listDirectory(const Task& task);
+
+    /**
+      Read a ROM and compute its entry in the cache.
+    */
+    void indexRom(const FilesystemNode& rom, bool romInfo);
+
+  private:
+    RomCache& myCache;
+    const Settings& mySettings;
+
+    vector<std::thread> myThreads;
+
+    mutable std::mutex myMutex;
+    std::condition_variable myWakeup;
+
+    // Pending directories and ROMs (all protected by the mutex)
+    std::deque<Task> myTasks;
+    uInt32 myActiveTasks{0};
+    uInt32 myGeneration{0};
+    bool myIsPaused{false};
+    bool myQuit{false};
+
+    // The paths of all ROMs queued in this session
+    std::unordered_set<string> myQueued;
+
+    // Indexed ROMs, waiting to be stored in the cache
+    vector<std::pair<FilesystemNode, RomCache::Entry>> myResults;
+
+    std::atomic<uInt32> myFound{0};
+    std::atomic<uInt32> myIndexed{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndexer() = delete;
+    RomIndexer(const RomIndexer&) = delete;
+    RomIndexer(RomIndexer&&) = delete;
+    RomIndexer& operator=(const RomIndexer&) = delete;
+    RomIndexer& operator=(RomIndexer&&) = delete;
+};
+
+#endif
@@ -144,11 +144,17 @@ void SoundSDL2::open(shared_ptr<AudioQueue> audioQueue,
   myAudioQueue = audioQueue;
   myUnderrun = true;
   myCurrentFragment = nullptr;
+  myConsumedFragments = 0;
 
   // Adjust volume to that defined in settings
   setVolume(myAudioSettings.volume());
 
   initResampler();
+  myMaxRateAdjustment = myAudioSettings.dynamicRate();
+  myFillLevel = myEmulationTiming->prebufferFragmentCount();
+  myRateAdjustment = 0;
+  myAudioQueue->telemetry().setSinkFormat(myEmulationTiming->audioSampleRate(),
+      myAudioQueue->fragmentSize(), myHardwareSpec.freq, myHardwareSpec.samples);
 
   // Show some info
   myAboutString = about();
@@ -168,6 +174,8 @@ void SoundSDL2::close()
 
   mute(true);
 
+  if (myAudioQueue && myAudioQueue->telemetry().enabled()) saveTelemetry();
+
   if (myAudioQueue) myAudioQueue->closeSink(myCurrentFragment);
   myAudioQueue.reset();
   myCurrentFragment = nullptr;
@@ -306,10 +314,56 @@ string SoundSDL2::about() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::processFragment(float* stream, uInt32 length)
 {
+  if (myMaxRateAdjustment > 0) updateRateAdjustment();
+
+  // Volume is applied by the resampler while writing the output
+  myResampler->setVolume(myVolumeFactor);
   myResampler->fillFragment(stream, length);
 
-  for (uInt32 i = 0; i < length; ++i)
-    stream[i] *= myVolumeFactor;
+  AudioTelemetry& telemetry = myAudioQueue->telemetry();
+  if (telemetry.enabled())
+    telemetry.recordCallback(myAudioQueue->size(), myConsumedFragments,
+                             myHardwareSpec.channels > 1 ? length >> 1 : length,
+                             myRateAdjustment);
+  myConsumedFragments = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::updateRateAdjustment()
+{
+  // The queue is filled in bursts (one timeslice at a time), so we low-pass
+  // the fill level before using it
+  constexpr double FILL_LEVEL_SMOOTHING = 0.02;
+  // Adjustment per fragment of deviation from the target level
+  constexpr double PPM_PER_FRAGMENT = 100.;
+
+  // Don't react to the queue draining during an underrun; playback will resume
+  // with a freshly prebuffered queue
+  if (myUnderrun) return;
+
+  myFillLevel += (static_cast<double>(myAudioQueue->size()) - myFillLevel) * FILL_LEVEL_SMOOTHING;
+
+  const double maxAdjustment = static_cast<double>(myMaxRateAdjustment);
+  const double deviation =
+    myFillLevel - static_cast<double>(myEmulationTiming->prebufferFragmentCount());
+
+  myRateAdjustment = BSPF::clamp(deviation * PPM_PER_FRAGMENT, -maxAdjustment, maxAdjustment);
+  myResampler->setRateAdjustment(myRateAdjustment);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::saveTelemetry()
+{
+  const string path = myOSystem.baseDir() + "audio_telemetry.csv";
+  ofstream out(path);
+
+  if (!out) {
+    Logger::error("Unable to save audio telemetry to " + path);
+    return;
+  }
+
+  myAudioQueue->telemetry().saveCSV(out);
+  Logger::info("Audio telemetry saved to " + path);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -324,8 +378,14 @@ void SoundSDL2::initResampler()
     else
       nextFragment = myAudioQueue->dequeue(myCurrentFragment);
 
+    if (nextFragment) {
+      myCurrentFragment = nextFragment;
+      ++myConsumedFragments;
+    }
+    else if (!myUnderrun)
+      myAudioQueue->telemetry().recordUnderrun();
+
     myUnderrun = nextFragment == nullptr;
-    if (nextFragment) myCurrentFragment = nextFragment;
 
     return nextFragment;
   };
@@ -128,6 +128,18 @@ class SoundSDL2 : public Sound
 
     void initResampler();
 
+    /**
+      Write the audio telemetry of the current queue to the base directory.
+    */
+    void saveTelemetry();
+
+    /**
+      Dynamic rate control: nudge the resampling rate in order to keep the
+      fill level of the audio queue close to the prebuffer level. This
+      compensates for the drift between emulation and audio hardware clocks.
+    */
+    void updateRateAdjustment();
+
   private:
     // Indicates if the sound device was successfully initialized
     bool myIsInitializedFlag{false};
@@ -148,6 +160,15 @@ class SoundSDL2 : public Sound
     Int16* myCurrentFragment{nullptr};
     bool myUnderrun{false};
 
+    // Fragments dequeued during the current callback (for telemetry)
+    uInt32 myConsumedFragments{0};
+
+    // Dynamic rate control: maximum adjustment (ppm, 0 = disabled), smoothed
+    // queue fill level (fragments) and current adjustment (ppm)
+    uInt32 myMaxRateAdjustment{0};
+    double myFillLevel{0};
+    double myRateAdjustment{0};
+
     unique_ptr<Resampler> myResampler;
 
     AudioSettings& myAudioSettings;
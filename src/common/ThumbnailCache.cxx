@@ -0,0 +1,172 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#if defined(PNG_SUPPORT)
+
+#include "ThumbnailCache.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbnailCache::~ThumbnailCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myWakeup.notify_all();
+
+  if(myThread.joinable())
+    myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbnailCache::State ThumbnailCache::get(const string& filename,
+    shared_ptr<const Image>& image, string& error)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    auto iter = myEntries.find(filename);
+    if(iter != myEntries.end())
+    {
+      Entry& entry = iter->second;
+      entry.lastUsed = ++myTime;
+
+      if(!entry.ready)
+        return State::pending;
+
+      image = entry.image;
+      error = entry.error;
+      return image ? State::ready : State::failed;
+    }
+
+    // The selection has changed, so the prefetches for the previous one
+    // aren't needed anymore
+    for(const auto& queued: myQueue)
+      myEntries.erase(queued);
+    myQueue.clear();
+
+    queue(filename, true);
+  }
+  myWakeup.notify_one();
+
+  return State::pending;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbnailCache::prefetch(const string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    if(myEntries.find(filename) != myEntries.end())
+      return;
+
+    queue(filename, false);
+  }
+  myWakeup.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbnailCache::clear()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  myEntries.clear();
+  myQueue.clear();
+  ++myGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbnailCache::queue(const string& filename, bool first)
+{
+  // The thread is only started when it is needed
+  if(!myThread.joinable())
+    myThread = std::thread(&ThumbnailCache::workerLoop, this);
+
+  myEntries[filename].lastUsed = ++myTime;
+  if(first)
+    myQueue.push_front(filename);
+  else
+    myQueue.push_back(filename);
+
+  evict();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbnailCache::evict()
+{
+  // Pending entries are never removed, as they will be filled by the thread
+  while(myEntries.size() > CACHE_SIZE)
+  {
+    auto oldest = myEntries.end();
+    for(auto iter = myEntries.begin(); iter != myEntries.end(); ++iter)
+      if(iter->second.ready &&
+         (oldest == myEntries.end() || iter->second.lastUsed < oldest->second.lastUsed))
+        oldest = iter;
+
+    if(oldest == myEntries.end())
+      break;
+    myEntries.erase(oldest);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbnailCache::workerLoop()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  for(;;)
+  {
+    myWakeup.wait(lock, [this] { return myQuit || !myQueue.empty(); });
+    if(myQuit)
+      return;
+
+    const string filename = myQueue.front();
+    const uInt32 generation = myGeneration;
+    myQueue.pop_front();
+
+    // Decode the image without holding the lock
+    lock.unlock();
+
+    auto image = make_shared<Image>();
+    string error;
+    try
+    {
+      PNGLibrary::readImage(filename, *image);
+    }
+    catch(const runtime_error& e)
+    {
+      image.reset();
+      error = e.what();
+    }
+
+    lock.lock();
+
+    // The entry may have been dropped by clear() in the meantime
+    auto iter = myEntries.find(filename);
+    if(generation == myGeneration && iter != myEntries.end())
+    {
+      iter->second.image = image;
+      iter->second.error = error;
+      iter->second.ready = true;
+      evict();
+    }
+  }
+}
+
+#endif  // PNG_SUPPORT
@@ -0,0 +1,130 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#if defined(PNG_SUPPORT)
+
+#ifndef THUMBNAIL_CACHE_HXX
+#define THUMBNAIL_CACHE_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "bspf.hxx"
+#include "Rect.hxx"
+#include "Variant.hxx"
+#include "PNGLibrary.hxx"
+
+/**
+  This class decodes the snapshots shown in the ROM launcher in the
+  background, and keeps the most recently used images in memory.
+
+  The image of the selected ROM is decoded first, followed by the
+  prefetched images of its neighbours.  Since a prefetch is only useful
+  while the selection doesn't change, each new request drops the
+  prefetches which haven't been started yet.
+
+  The decoded images are RGB triples; they are converted into a surface by
+  the main thread (see PNGLibrary::loadImage).
+*/
+class ThumbnailCache
+{
+  public:
+    using Image = PNGLibrary::Image;
+
+    enum class State { pending, ready, failed };
+
+    ThumbnailCache() = default;
+    ~ThumbnailCache();
+
+    /**
+      Get the decoded image of the specified file.  If it isn't available
+      yet, it is decoded before any other queued files.
+
+      @param filename  The filename of the PNG image
+      @param image     The decoded image (if the result is 'ready')
+      @param error     The error message (if the result is 'failed')
+
+      @return  The state of the image
+    */
+    State get(const string& filename, shared_ptr<const Image>& image,
+              string& error);
+
+    /**
+      Decode the specified file, if it isn't available yet, after all
+      other queued files.
+
+      @param filename  The filename of the PNG image
+    */
+    void prefetch(const string& filename);
+
+    /**
+      Forget all images (e.g. because new snapshots have been saved).
+    */
+    void clear();
+
+  private:
+    struct Entry
+    {
+      shared_ptr<const Image> image;
+      string error;
+      bool ready{false};
+      uInt64 lastUsed{0};
+    };
+
+    /**
+      Create a pending entry for the file, and queue it.
+    */
+    void queue(const string& filename, bool first);
+
+    /**
+      Remove the least recently used images while the cache is too large.
+    */
+    void evict();
+
+    void workerLoop();
+
+  private:
+    // The number of decoded images kept in memory
+    static constexpr size_t CACHE_SIZE = 16;
+
+    std::thread myThread;
+
+    std::mutex myMutex;
+    std::condition_variable myWakeup;
+
+    // All protected by the mutex
+    std::unordered_map<string, Entry> myEntries;
+    std::deque<string> myQueue;
+    uInt64 myTime{0};
+    uInt32 myGeneration{0};  // images of older generations have been cleared
+    bool myQuit{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache(ThumbnailCache&&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(ThumbnailCache&&) = delete;
+};
+
+#endif
+
+#endif  // PNG_SUPPORT
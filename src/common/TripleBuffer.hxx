@@ -0,0 +1,84 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TRIPLE_BUFFER_HXX
+#define TRIPLE_BUFFER_HXX
+
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+  A lock-free "latest value" slot between one producer and one consumer
+  thread.  The producer fills the back buffer and publishes it; the consumer
+  picks up the most recently published buffer.  Neither side ever waits for
+  the other, and buffers which are not picked up in time are simply
+  overwritten.
+*/
+template<class T>
+class TripleBuffer
+{
+  public:
+    TripleBuffer() = default;
+
+    /**
+      The buffer that is filled by the producer.
+    */
+    T& back() { return myBuffers[myBack]; }
+
+    /**
+      Publish the back buffer (producer).
+    */
+    void publish() {
+      myBack = myMiddle.exchange(myBack | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    /**
+      Pick up the most recently published buffer (consumer).
+
+      @return  False if nothing has been published since the last call
+    */
+    bool consume() {
+      if((myMiddle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+
+      myFront = myMiddle.exchange(myFront, std::memory_order_acq_rel) & INDEX;
+      return true;
+    }
+
+    /**
+      The buffer picked up by the last call of consume.
+    */
+    const T& front() const { return myBuffers[myFront]; }
+
+  private:
+    static constexpr uInt8 INDEX = 0x03, FRESH = 0x04;
+
+    std::array<T, 3> myBuffers;
+
+    uInt8 myBack{0};
+    std::atomic<uInt8> myMiddle{1};
+    uInt8 myFront{2};
+
+  private:
+    // Following constructors and assignment operators not supported
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer(TripleBuffer&&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(TripleBuffer&&) = delete;
+};
+
+#endif // TRIPLE_BUFFER_HXX
@@ -18,13 +18,18 @@
 #ifndef VARIANT_HXX
 #define VARIANT_HXX
 
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
 #include "Rect.hxx"
 #include "bspf.hxx"
 
 /**
   This class implements a very simple variant type, which is convertible
   to several other types.  It stores the actual data as a string, and
-  converts to other types as required.  Eventually, this class may be
+  converts to other types as required.  The conversions don't use any
+  shared state, so variants can be used from any thread.  Eventually, this class may be
   extended to use templates and become a more full-featured variant type.
 
   @author  Stephen Anthony
@@ -35,42 +40,47 @@ class Variant
     // Underlying data store is (currently) always a string
     string data;
 
-    // Use singleton so we use only one ostringstream object
-    static ostringstream& buf() {
-      static ostringstream buf;
+    // Format a floating point number like an ostream with default settings
+    static string format(double d) {
+      char buf[32];
+      std::snprintf(buf, sizeof(buf), "%g", d);
       return buf;
     }
 
+    template<typename T>
+    static string format(const T& t) {
+      ostringstream buf;
+      buf << t;
+      return buf.str();
+    }
+
   public:
     Variant() { }  // NOLINT
 
     Variant(const string& s) : data(s) { }
     Variant(const char* s) : data(s) { }
 
-    Variant(Int32 i)  { buf().str(""); buf() << i; data = buf().str(); }
-    Variant(uInt32 i) { buf().str(""); buf() << i; data = buf().str(); }
-    Variant(float f)  { buf().str(""); buf() << f; data = buf().str(); }
-    Variant(double d) { buf().str(""); buf() << d; data = buf().str(); }
-    Variant(bool b)   { buf().str(""); buf() << b; data = buf().str(); }
-    Variant(const Common::Size& s) { buf().str(""); buf() << s; data = buf().str(); }
-    Variant(const Common::Point& s) { buf().str(""); buf() << s; data = buf().str(); }
+    Variant(Int32 i)  : data(std::to_string(i)) { }
+    Variant(uInt32 i) : data(std::to_string(i)) { }
+    Variant(float f)  : data(format(double(f))) { }
+    Variant(double d) : data(format(d)) { }
+    Variant(bool b)   : data(b ? "1" : "0") { }
+    Variant(const Common::Size& s) : data(format(s)) { }
+    Variant(const Common::Point& s) : data(format(s)) { }
 
     // Conversion methods
+    // Like reading from a stream, numbers are parsed up to the first invalid
+    // character, and values out of range are clamped
     const string& toString() const { return data; }
     const char* toCString() const { return data.c_str(); }
     Int32 toInt() const {
-      istringstream ss(data);
-      Int32 parsed;
-      ss >> parsed;
+      const long parsed = std::strtol(data.c_str(), nullptr, 10);
 
-      return parsed;
+      return Int32(BSPF::clamp(parsed, long(std::numeric_limits<Int32>::min()),
+                               long(std::numeric_limits<Int32>::max())));
     }
     float toFloat() const {
-      istringstream ss(data);
-      float parsed;
-      ss >> parsed;
-
-      return parsed;
+      return std::strtof(data.c_str(), nullptr);
     }
     bool toBool() const         { return data == "1" || data == "true"; }
     Common::Size toSize() const { return Common::Size(data); }
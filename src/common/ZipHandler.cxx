@@ -19,105 +19,70 @@
 
 #include <zlib.h>
 
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#elif defined(BSPF_WINDOWS)
+  #include <windows.h>
+#endif
+
 #include "Bankswitch.hxx"
+#include "FSNodeFactory.hxx"
 #include "ZipHandler.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::open(const string& filename)
 {
-  // Close already open file (if any) and add to cache
-  addToCache();
-
   // Ensure we start with a nullptr result
-  myZip.reset();
-
-  ZipFilePtr ptr = findCached(filename);
-  if(ptr)
-  {
-    // Only a previously used entry will exist in the cache, so we know it's valid
-    myZip = std::move(ptr);
-
-    // Was already initialized; we just need to re-open it
-    if(!myZip->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  }
-  else
-  {
-    // Allocate memory for the ZipFile structure
-    ptr = make_unique<ZipFile>(filename);
-    if(ptr == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
-
-    // Open the file and initialize it
-    if(!ptr->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    try
-    {
-      ptr->initialize();
-    }
-    catch(...)
-    {
-      throw;
-    }
-
-    myZip = std::move(ptr);
-
-    // Count ROM files (we do it here so it will be cached)
-    while(hasNext())
-      if(Bankswitch::isValidRomName(next()))
-        myZip->myRomfiles++;
-  }
+  myIndex.reset();
+  myPos = 0;
 
-  reset();  // Reset iterator to beginning for subsequent use
+  myIndex = findIndex(filename);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::reset()
 {
   // Reset the position and go from there
-  if(myZip)
-    myZip->myCdPos = 0;
+  myPos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext() const
 {
-  return myZip && (myZip->myCdPos < myZip->myEcd.cdSize);
+  return myIndex && (myPos < myIndex->myHeaders.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& ZipHandler::next()
 {
   if(hasNext())
-  {
-    const ZipHeader* header = myZip->nextFile();
-    if(!header || header->uncompressedLength == 0)
-      return next();
-    else
-      return header->filename;
-  }
+    return myIndex->myHeaders[myPos++].filename;
+
   return EmptyString;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 ZipHandler::decompress(ByteBuffer& image)
 {
-  if(myZip && myZip->myHeader.uncompressedLength > 0)
+  if(myIndex && myPos > 0)
   {
-    uInt64 length = myZip->myHeader.uncompressedLength;
+    const ZipHeader& header = myIndex->myHeaders[myPos - 1];
+    uInt64 length = header.uncompressedLength;
     image = make_unique<uInt8[]>(length);
     if(image == nullptr)
       throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
 
-    try
-    {
-      myZip->decompress(image, length);
-      return length;
-    }
-    catch(const ZipError& err)
-    {
-      throw runtime_error(errorMessage(err));
-    }
+    // The file is only mapped while decompressing, so that no handles
+    // are kept open for the cached ZIP files
+    MappedFile file(myIndex->myFilename);
+    if(!file.isOpen() || file.size() != myIndex->myLength)
+      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+
+    myIndex->decompress(file, header, image, length);
+    return length;
   }
   else
     throw runtime_error("Invalid ZIP archive");
@@ -142,361 +107,331 @@ string ZipHandler::errorMessage(ZipError err)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipFilePtr ZipHandler::findCached(const string& filename)
+ZipHandler::ZipIndexPtr ZipHandler::findIndex(const string& filename)
 {
-  for(size_t cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
+  // The cached index is only valid as long as the file is unchanged
+  AbstractFSNodePtr node =
+      FilesystemNodeFactory::create(filename, FilesystemNodeFactory::Type::SYSTEM);
+  const size_t length = node->getSize();
+  const uInt64 modified = node->getLastModified();
+
   {
-    // If we have a valid entry and it matches our filename,
-    // use it and remove from the cache
-    if(myZipCache[cachenum] && (filename == myZipCache[cachenum]->myFilename))
+    std::lock_guard<std::mutex> lock(ourCacheMutex);
+
+    auto cached = ourCache.find(filename);
+    if(cached != ourCache.end())
     {
-      ZipFilePtr result;
-      std::swap(myZipCache[cachenum], result);
-      return result;
+      if(cached->second.index->myLength == length &&
+         cached->second.index->myModified == modified)
+      {
+        cached->second.lastUsed = ++ourCacheTime;
+        return cached->second.index;
+      }
+      ourCache.erase(cached);
     }
   }
-  return ZipFilePtr();
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::addToCache()
-{
-  if(myZip == nullptr)
-    return;
+  // Parse the file outside of the lock; in the unlikely case that another
+  // thread parses the same file meanwhile, the last index simply wins
+  MappedFile file(filename);
+  if(!file.isOpen())
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
 
-  // Close the open file
-  myZip->close();
+  auto index = make_shared<ZipIndex>();
+  index->myFilename = filename;
+  index->myLength = size_t(file.size());
+  index->myModified = modified;
+  index->initialize(file);
 
-  // Find the first nullptr entry in the cache
-  size_t cachenum;
-  for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-    if(myZipCache[cachenum] == nullptr)
-      break;
+  std::lock_guard<std::mutex> lock(ourCacheMutex);
 
-  // If no room left in the cache, free the bottommost entry
-  if(cachenum == myZipCache.size())
+  // If no room left in the cache, free the least recently used entry
+  if(ourCache.size() >= CACHE_SIZE)
   {
-    cachenum--;
-    myZipCache[cachenum].reset();
+    auto oldest = ourCache.begin();
+    for(auto it = ourCache.begin(); it != ourCache.end(); ++it)
+      if(it->second.lastUsed < oldest->second.lastUsed)
+        oldest = it;
+    ourCache.erase(oldest);
   }
+  ourCache[filename] = CacheEntry{index, ++ourCacheTime};
 
-  for( ; cachenum > 0; --cachenum)
-    myZipCache[cachenum] = std::move(myZipCache[cachenum - 1]);
-  myZipCache[0] = std::move(myZip);
-
-#if 0
-  cerr << "\nCACHE contents:\n";
-    for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-      if(myZipCache[cachenum] != nullptr)
-        cerr << "  " << cachenum << " : " << myZipCache[cachenum]->filename << endl;
-  cerr << endl;
-#endif
+  return index;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipFile::ZipFile(const string& filename)
-  : myFilename(filename),
-    myBuffer(make_unique<uInt8[]>(DECOMPRESS_BUFSIZE))
+ZipHandler::MappedFile::MappedFile(const string& filename)
 {
-  std::fill(myBuffer.get(), myBuffer.get() + DECOMPRESS_BUFSIZE, 0);
-}
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::open()
-{
-  myStream.open(myFilename, fstream::in | fstream::binary);
-  if(!myStream.is_open())
+  struct stat st;
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
   {
-    myLength = 0;
-    return false;
+    void* data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data != MAP_FAILED)
+    {
+      myData = static_cast<const uInt8*>(data);
+      mySize = uInt64(st.st_size);
+    }
   }
-  myStream.exceptions( std::ios_base::failbit | std::ios_base::badbit | std::ios_base::eofbit );
-  myStream.seekg(0, std::ios::end);
-  myLength = myStream.tellg();
-  myStream.seekg(0, std::ios::beg);
-
-  return true;
-}
+  // The mapping remains valid after closing the file
+  ::close(fd);
+#elif defined(BSPF_WINDOWS)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    return;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::initialize()
-{
-  try
+  LARGE_INTEGER size;
+  if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
   {
-    // Read ecd data
-    readEcd();
-
-    // Verify that we can work with this zipfile (no disk spanning allowed)
-    if(myEcd.diskNumber != myEcd.cdStartDiskNumber ||
-       myEcd.cdDiskEntries != myEcd.cdTotalEntries)
-      throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping != nullptr)
+    {
+      void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if(data != nullptr)
+      {
+        myData = static_cast<const uInt8*>(data);
+        mySize = uInt64(size.QuadPart);
+      }
+      // The view remains valid after closing the handles
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+#else
+  ifstream in(filename, std::ios::binary);
+  if(!in)
+    return;
 
-    // Allocate memory for the central directory
-    myCd = make_unique<uInt8[]>(myEcd.cdSize + 1);
-    if(myCd == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+  in.seekg(0, std::ios::end);
+  const std::streamoff size = in.tellg();
+  if(size <= 0)
+    return;
+  in.seekg(0, std::ios::beg);
 
-    // Read the central directory
-    uInt64 read_length = 0;
-    bool success = readStream(myCd, myEcd.cdStartDiskOffset, myEcd.cdSize, read_length);
-    if(!success)
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    else if(read_length != myEcd.cdSize)
-      throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
-  }
-  catch(...)
+  myBuffer = make_unique<uInt8[]>(size_t(size));
+  if(in.read(reinterpret_cast<char*>(myBuffer.get()), size))
   {
-    throw;
+    myData = myBuffer.get();
+    mySize = uInt64(size);
   }
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::close()
+ZipHandler::MappedFile::~MappedFile()
 {
-  if(myStream.is_open())
-    myStream.close();
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+  if(myData)
+    munmap(const_cast<uInt8*>(myData), size_t(mySize));
+#elif defined(BSPF_WINDOWS)
+  if(myData)
+    UnmapViewOfFile(myData);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::readEcd()
+void ZipHandler::ZipIndex::initialize(const MappedFile& file)
 {
-  uInt64 buflen = 1024;
-  ByteBuffer buffer;
-
-  // We may need multiple tries
-  while(buflen < 65536)
-  {
-    uInt64 read_length;
+  // Read ecd data
+  readEcd(file);
 
-    // Max out the buf length at the size of the file
-    if(buflen > myLength)
-      buflen = myLength;
+  // Verify that we can work with this zipfile (no disk spanning allowed)
+  if(myEcd.diskNumber != myEcd.cdStartDiskNumber ||
+     myEcd.cdDiskEntries != myEcd.cdTotalEntries)
+    throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-    // Allocate buffer
-    buffer = make_unique<uInt8[]>(buflen + 1);
-    if(buffer == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+  // Make sure the central directory is within the file
+  if(myEcd.cdStartDiskOffset > myLength ||
+     myEcd.cdSize > myLength - myEcd.cdStartDiskOffset)
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
-    // Read in one buffers' worth of data
-    bool success = readStream(buffer, myLength - buflen, buflen, read_length);
-    if(!success || read_length != buflen)
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+  // Parse the central directory, keeping all entries which contain data
+  const uInt8* cd = file.data() + myEcd.cdStartDiskOffset;
+  uInt64 pos = 0;
+  while(pos + CentralDirEntryReader::minimumLength() <= myEcd.cdSize)
+  {
+    CentralDirEntryReader const reader(cd + pos);
+    if(!reader.signatureCorrect() || ((pos + reader.totalLength()) > myEcd.cdSize))
+      break;
 
-    // Find the ECD signature
-    Int32 offset;
-		for(offset = Int32(buflen - EcdReader::minimumLength()); offset >= 0; --offset)
-    {
-      EcdReader reader(buffer.get() + offset);
-      if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= buflen))
-        break;
-    }
+    // Advance the position
+    pos += reader.totalLength();
+
+    if(reader.uncompressedSize() == 0)
+      continue;
+
+    // Extract file header info
+    ZipHeader header;
+    header.versionCreated     = reader.versionCreated();
+    header.versionNeeded      = reader.versionNeeded();
+    header.bitFlag            = reader.generalFlag();
+    header.compression        = reader.compressionMethod();
+    header.fileTime           = reader.modifiedTime();
+    header.fileDate           = reader.modifiedDate();
+    header.crc                = reader.crc32();
+    header.compressedLength   = reader.compressedSize();
+    header.uncompressedLength = reader.uncompressedSize();
+    header.startDiskNumber    = reader.startDisk();
+    header.localHeaderOffset  = reader.headerOffset();
+    header.filename           = reader.filename();
 
-    // If we found it, fill out the data
-    if(offset >= 0)
-    {
-      // Extract ECD info
-      EcdReader const reader(buffer.get() + offset);
-      myEcd.diskNumber        = reader.thisDiskNo();
-      myEcd.cdStartDiskNumber = reader.dirStartDisk();
-      myEcd.cdDiskEntries     = reader.dirDiskEntries();
-      myEcd.cdTotalEntries    = reader.dirTotalEntries();
-      myEcd.cdSize            = reader.dirSize();
-      myEcd.cdStartDiskOffset = reader.dirOffset();
-      return;
-    }
+    // Count ROM files (we do it here so it will be cached)
+    if(Bankswitch::isValidRomName(header.filename))
+      myRomfiles++;
 
-    // Didn't find it; expand our search
-    if(buflen < myLength)
-      buflen *= 2;
-    else
-      throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
+    myHeaders.push_back(std::move(header));
   }
-  throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::readStream(ByteBuffer& out, uInt64 offset,
-                                     uInt64 length, uInt64& actual)
+void ZipHandler::ZipIndex::readEcd(const MappedFile& file)
 {
-  try
-  {
-    myStream.seekg(offset);
-    myStream.read(reinterpret_cast<char*>(out.get()), length);
+  // The ECD (including its comment) is within the last 64K of the file
+  const uInt64 buflen = std::min<uInt64>(myLength, 65536 + EcdReader::minimumLength());
+  const uInt8* buffer = file.data() + myLength - buflen;
+
+  if(buflen < EcdReader::minimumLength())
+    throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-    actual = myStream.gcount();
-    return true;
+  // Find the ECD signature
+  Int32 offset;
+  for(offset = Int32(buflen - EcdReader::minimumLength()); offset >= 0; --offset)
+  {
+    EcdReader reader(buffer + offset);
+    if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= buflen))
+      break;
   }
-  catch(...)
+
+  // If we found it, fill out the data
+  if(offset >= 0)
   {
-    return false;
+    // Extract ECD info
+    EcdReader const reader(buffer + offset);
+    myEcd.diskNumber        = reader.thisDiskNo();
+    myEcd.cdStartDiskNumber = reader.dirStartDisk();
+    myEcd.cdDiskEntries     = reader.dirDiskEntries();
+    myEcd.cdTotalEntries    = reader.dirTotalEntries();
+    myEcd.cdSize            = reader.dirSize();
+    myEcd.cdStartDiskOffset = reader.dirOffset();
+    return;
   }
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ZipHandler::ZipHeader* ZipHandler::ZipFile::nextFile()
-{
-  // Make sure we have enough data
-  // If we're at or past the end, we're done
-  CentralDirEntryReader const reader(myCd.get() + myCdPos);
-  if(!reader.signatureCorrect() || ((myCdPos + reader.totalLength()) > myEcd.cdSize))
-    return nullptr;
-
-  // Extract file header info
-  myHeader.versionCreated     = reader.versionCreated();
-  myHeader.versionNeeded      = reader.versionNeeded();
-  myHeader.bitFlag            = reader.generalFlag();
-  myHeader.compression        = reader.compressionMethod();
-  myHeader.crc                = reader.crc32();
-  myHeader.compressedLength   = reader.compressedSize();
-  myHeader.uncompressedLength = reader.uncompressedSize();
-  myHeader.startDiskNumber    = reader.startDisk();
-  myHeader.localHeaderOffset  = reader.headerOffset();
-  myHeader.filename           = reader.filename();
-
-  // Advance the position
-  myCdPos += reader.totalLength();
-  return &myHeader;
+  throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompress(ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipIndex::decompress(const MappedFile& file,
+    const ZipHeader& header, ByteBuffer& out, uInt64 length) const
 {
   // If we don't have enough buffer, error
-  if(length < myHeader.uncompressedLength)
+  if(length < header.uncompressedLength)
     throw runtime_error(errorMessage(ZipError::BUFFER_TOO_SMALL));
 
   // Make sure the info in the header aligns with what we know
-  if(myHeader.startDiskNumber != myEcd.diskNumber)
+  if(header.startDiskNumber != myEcd.diskNumber)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  try
-  {
-    // Get the compressed data offset
-    uInt64 offset = getCompressedDataOffset();
+  // Get the compressed data offset
+  uInt64 offset = getCompressedDataOffset(file, header);
 
-    // Handle compression types
-    switch(myHeader.compression)
-    {
-      case 0:
-        decompressDataType0(offset, out, length);
-        break;
+  // Make sure the compressed data is within the file
+  if(header.compressedLength > file.size() - offset)
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
-      case 8:
-        decompressDataType8(offset, out, length);
-        break;
+  // Handle compression types
+  switch(header.compression)
+  {
+    case 0:
+      decompressDataType0(file, header, offset, out, length);
+      break;
 
-      case 14:
-        // FIXME - LZMA format not yet supported
-        throw runtime_error(errorMessage(ZipError::LZMA_UNSUPPORTED));
+    case 8:
+      decompressDataType8(file, header, offset, out, length);
+      break;
 
-      default:
-        throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
-    }
-  }
-  catch(...)
-  {
-    throw;
+    case 14:
+      // FIXME - LZMA format not yet supported
+      throw runtime_error(errorMessage(ZipError::LZMA_UNSUPPORTED));
+
+    default:
+      throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt64 ZipHandler::ZipFile::getCompressedDataOffset()
+uInt64 ZipHandler::ZipIndex::getCompressedDataOffset(const MappedFile& file,
+    const ZipHeader& header) const
 {
   // Don't support a number of features
-  GeneralFlagReader const flags(myHeader.bitFlag);
-  if(myHeader.startDiskNumber != myEcd.diskNumber ||
-     myHeader.versionNeeded > 63 || flags.patchData() ||
+  GeneralFlagReader const flags(header.bitFlag);
+  if(header.startDiskNumber != myEcd.diskNumber ||
+     header.versionNeeded > 63 || flags.patchData() ||
      flags.encrypted() || flags.strongEncryption())
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  // Read the fixed-sized part of the local file header
-  uInt64 read_length = 0;
-  bool success = readStream(myBuffer, myHeader.localHeaderOffset, 0x1e, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != LocalFileHeaderReader::minimumLength())
+  // Check the fixed-sized part of the local file header
+  if(header.localHeaderOffset > file.size() ||
+     file.size() - header.localHeaderOffset < LocalFileHeaderReader::minimumLength())
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
   // Compute the final offset
-  LocalFileHeaderReader reader(&myBuffer[0]);
+  LocalFileHeaderReader reader(file.data() + header.localHeaderOffset);
   if(!reader.signatureCorrect())
     throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-  return myHeader.localHeaderOffset + reader.totalLength();
+  const uInt64 offset = header.localHeaderOffset + reader.totalLength();
+  if(offset > file.size())
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+
+  return offset;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType0(
-    uInt64 offset, ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipIndex::decompressDataType0(const MappedFile& file,
+    const ZipHeader& header, uInt64 offset, ByteBuffer& out, uInt64 length)
 {
-  // The data is uncompressed; just read it
-  uInt64 read_length = 0;
-  bool success = readStream(out, offset, myHeader.compressedLength, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myHeader.compressedLength)
-    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+  // The data is uncompressed, so both lengths must agree; otherwise the
+  // copy could run past the end of the output buffer
+  if(header.compressedLength != header.uncompressedLength ||
+     header.compressedLength > length)
+    throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
+
+  // Just copy it
+  std::copy_n(file.data() + offset, header.compressedLength, out.get());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType8(
-    uInt64 offset, ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipIndex::decompressDataType8(const MappedFile& file,
+    const ZipHeader& header, uInt64 offset, ByteBuffer& out, uInt64 length)
 {
-  uInt64 input_remaining = myHeader.compressedLength;
-
   // Reset the stream
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-	stream.avail_in = 0;
-	stream.next_out = reinterpret_cast<Bytef *>(out.get());
-	stream.avail_out = uInt32(length); // TODO - use zip64
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.avail_in = 0;
+  stream.next_out = reinterpret_cast<Bytef *>(out.get());
+  stream.avail_out = uInt32(length); // TODO - use zip64
 
   // Initialize the decompressor
   int zerr = inflateInit2(&stream, -MAX_WBITS);
   if(zerr != Z_OK)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 
-  // Loop until we're done
-  for(;;)
-  {
-    // Read in the next chunk of data
-    uInt64 read_length = 0;
-    bool success = readStream(myBuffer, offset,
-          std::min(input_remaining, uInt64(sizeof(myBuffer.get()))), read_length);
-    if(!success)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    }
-    offset += read_length;
-
-    // If we read nothing, but still have data left, the file is truncated
-    if(read_length == 0 && input_remaining > 0)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
-    }
-
-    // Fill out the input data
-    stream.next_in = myBuffer.get();
-    stream.avail_in = uInt32(read_length); // TODO - use zip64
-    input_remaining -= read_length;
-
-    // Add a dummy byte at end of compressed data
-    if(input_remaining == 0)
-      stream.avail_in++;
+  // All the compressed data is mapped, so it's inflated in one go
+  stream.next_in = const_cast<Bytef *>(file.data() + offset);
+  stream.avail_in = uInt32(header.compressedLength); // TODO - use zip64
 
-    // Now inflate
-    zerr = inflate(&stream, Z_NO_FLUSH);
-    if(zerr == Z_STREAM_END)
-      break;
-    else if(zerr != Z_OK)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
-    }
+  zerr = inflate(&stream, Z_FINISH);
+  if(zerr != Z_STREAM_END)
+  {
+    inflateEnd(&stream);
+    throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
   }
 
   // Finish decompression
@@ -505,8 +440,13 @@ void ZipHandler::ZipFile::decompressDataType8(
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 
   // If anything looks funny, report an error
-  if(stream.avail_out > 0 || input_remaining > 0)
+  if(stream.avail_out > 0)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::map<string, ZipHandler::CacheEntry> ZipHandler::ourCache;
+uInt64 ZipHandler::ourCacheTime = 0;
+std::mutex ZipHandler::ourCacheMutex;
+
 #endif  /* ZIP_SUPPORT */
@@ -20,12 +20,20 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <map>
+#include <mutex>
+
 #include "bspf.hxx"
 
 /**
   This class implements a thin wrapper around the zip file management code
   from the MAME project.
 
+  The central directory of each ZIP file is parsed only once, and kept in a
+  process-wide cache (validated by the size and modification time of the
+  file), which is shared by all handlers.  The files are decompressed on
+  demand, directly from a memory mapping of the ZIP file.
+
   @author  Original code by Aaron Giles, ZipHandler wrapper class and heavy
            modifications/refactoring by Stephen Anthony.
 */
@@ -48,7 +56,7 @@ class ZipHandler
     uInt64 decompress(ByteBuffer& image);
 
     // Answer the number of ROM files (with a valid extension) found
-    uInt16 romFiles() const { return myZip ? myZip->myRomfiles : 0; }
+    uInt16 romFiles() const { return myIndex ? myIndex->myRomfiles : 0; }
 
   private:
     // Error types
@@ -94,56 +102,68 @@ class ZipHandler
       uInt64 cdStartDiskOffset{0}; // offset of start of central directory with respect to the starting disk number
     };
 
-    // Describes an open ZIP file
-    struct ZipFile
+    // A read-only memory mapping of a file
+    class MappedFile
     {
-      string  myFilename;     // copy of ZIP filename (for caching)
-      fstream myStream;       // C++ fstream file handle
-      uInt64  myLength{0};    // length of zip file
-      uInt16  myRomfiles{0};  // number of ROM files in central directory
+      public:
+        explicit MappedFile(const string& filename);
+        ~MappedFile();
 
-      ZipEcd  myEcd;          // end of central directory
+        bool isOpen() const { return myData != nullptr; }
+        const uInt8* data() const { return myData; }
+        uInt64 size() const { return mySize; }
 
-      ByteBuffer myCd;        // central directory raw data
-      uInt64    myCdPos{0};   // position in central directory
-      ZipHeader myHeader;     // current file header
+      private:
+        const uInt8* myData{nullptr};
+        uInt64 mySize{0};
+      #if !defined(BSPF_UNIX) && !defined(BSPF_MACOS) && !defined(BSPF_WINDOWS)
+        ByteBuffer myBuffer;  // no mapping available; the file is read instead
+      #endif
 
-      ByteBuffer myBuffer;    // buffer for decompression
+      private:
+        // Following constructors and assignment operators not supported
+        MappedFile() = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+    };
 
-      /** Constructor */
-      explicit ZipFile(const string& filename);
+    // Describes the parsed central directory of a ZIP file
+    struct ZipIndex
+    {
+      string myFilename;       // copy of ZIP filename
+      size_t myLength{0};      // length of zip file
+      uInt64 myModified{0};    // modification time of zip file
+      uInt16 myRomfiles{0};    // number of ROM files in central directory
 
-      /** Open the file and set up the internal stream buffer*/
-      bool open();
+      ZipEcd myEcd;            // end of central directory
 
-      /** Read the ZIP contents from the internal stream buffer */
-      void initialize();
+      vector<ZipHeader> myHeaders;  // all files containing data
 
-      /** Close previously opened internal stream buffer */
-      void close();
+      /** Parse the central directory of the mapped file */
+      void initialize(const MappedFile& file);
 
       /** Read the ECD data */
-      void readEcd();
+      void readEcd(const MappedFile& file);
 
-      /** Read data from stream */
-      bool readStream(ByteBuffer& out, uInt64 offset, uInt64 length, uInt64& actual);
-
-      /** Return the next entry in the ZIP file */
-      const ZipHeader* nextFile();
-
-      /** Decompress the most recently found file in the ZIP into target buffer */
-      void decompress(ByteBuffer& out, uInt64 length);
+      /** Decompress the given file in the ZIP into target buffer */
+      void decompress(const MappedFile& file, const ZipHeader& header,
+                      ByteBuffer& out, uInt64 length) const;
 
       /** Return the offset of the compressed data */
-      uInt64 getCompressedDataOffset();
+      uInt64 getCompressedDataOffset(const MappedFile& file,
+                                     const ZipHeader& header) const;
 
       /** Decompress type 0 data (which is uncompressed) */
-      void decompressDataType0(uInt64 offset, ByteBuffer& out, uInt64 length);
+      static void decompressDataType0(const MappedFile& file, const ZipHeader& header,
+                                      uInt64 offset, ByteBuffer& out, uInt64 length);
 
       /** Decompress type 8 data (which is deflated) */
-      void decompressDataType8(uInt64 offset, ByteBuffer& out, uInt64 length);
+      static void decompressDataType8(const MappedFile& file, const ZipHeader& header,
+                                      uInt64 offset, ByteBuffer& out, uInt64 length);
     };
-    using ZipFilePtr = unique_ptr<ZipFile>;
+    using ZipIndexPtr = shared_ptr<const ZipIndex>;
 
     /** Classes to parse the ZIP metadata in an abstracted way */
     class ReaderBase
@@ -290,18 +310,26 @@ class ZipHandler
     /** Get message for given ZipError enumeration */
     static string errorMessage(ZipError err);
 
-    /** Search cache for given ZIP file */
-    ZipFilePtr findCached(const string& filename);
-
-    /** Close a ZIP file and add it to the cache */
-    void addToCache();
+    /** Get the index of the given ZIP file, from the cache if it's current */
+    static ZipIndexPtr findIndex(const string& filename);
 
   private:
-    static constexpr size_t DECOMPRESS_BUFSIZE = 16_KB;
-    static constexpr uInt32 CACHE_SIZE = 8; // number of open files to cache
+    static constexpr uInt32 CACHE_SIZE = 4096; // number of ZIP files to cache
+
+    // The current ZIP file, and the position of the iterator in its files
+    ZipIndexPtr myIndex;
+    size_t myPos{0};
+
+    struct CacheEntry
+    {
+      ZipIndexPtr index;
+      uInt64 lastUsed{0};
+    };
 
-    ZipFilePtr myZip;
-    std::array<ZipFilePtr, CACHE_SIZE> myZipCache;
+    // The indices of the most recently used ZIP files, for all handlers
+    static std::map<string, CacheEntry> ourCache;
+    static uInt64 ourCacheTime;
+    static std::mutex ourCacheMutex;
 
   private:
     // Following constructors and assignment operators not supported
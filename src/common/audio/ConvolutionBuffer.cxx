@@ -21,25 +21,6 @@
 ConvolutionBuffer::ConvolutionBuffer(uInt32 size)
   : mySize(size)
 {
-  myData = make_unique<float[]>(mySize);
-  std::fill_n(myData.get(), mySize, 0.F);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ConvolutionBuffer::shift(float nextValue)
-{
-  myData[myFirstIndex] = nextValue;
-  myFirstIndex = (myFirstIndex + 1) % mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float ConvolutionBuffer::convoluteWith(float* kernel) const
-{
-  float result = 0.F;
-
-  for (uInt32 i = 0; i < mySize; ++i) {
-    result += kernel[i] * myData[(myFirstIndex + i) % mySize];
-  }
-
-  return result;
+  myData = make_unique<float[]>(2 * mySize);
+  std::fill_n(myData.get(), 2 * mySize, 0.F);
 }
@@ -26,12 +26,28 @@ class ConvolutionBuffer
 
     explicit ConvolutionBuffer(uInt32 size);
 
-    void shift(float nextValue);
+    void shift(float nextValue)
+    {
+      // Every value is stored twice, so the last mySize values are always
+      // contiguous in memory, starting at myFirstIndex
+      myData[myFirstIndex] = myData[myFirstIndex + mySize] = nextValue;
+      if (++myFirstIndex == mySize) myFirstIndex = 0;
+    }
 
-    float convoluteWith(float* kernel) const;
+    float convoluteWith(const float* kernel) const
+    {
+      const float* data = myData.get() + myFirstIndex;
+      float result = 0.F;
+
+      for (uInt32 i = 0; i < mySize; ++i)
+        result += kernel[i] * data[i];
+
+      return result;
+    }
 
   private:
 
+    // Two copies of the buffer, see shift()
     unique_ptr<float[]> myData;
 
     uInt32 myFirstIndex{0};
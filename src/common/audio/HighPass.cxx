@@ -23,14 +23,3 @@ HighPass::HighPass(float cutOffFrequency, float frequency)
   : myAlpha(1.F / (1.F + 2.F*BSPF::PI_f*cutOffFrequency/frequency))
 {
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float HighPass::apply(float valueIn)
-{
-  float valueOut = myAlpha * (myLastValueOut + valueIn - myLastValueIn);
-
-  myLastValueIn = valueIn;
-  myLastValueOut = valueOut;
-
-  return valueOut;
-}
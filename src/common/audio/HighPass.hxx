@@ -24,7 +24,15 @@ class HighPass
 
     HighPass(float cutOffFrequency, float frequency);
 
-    float apply(float value);
+    float apply(float valueIn)
+    {
+      const float valueOut = myAlpha * (myLastValueOut + valueIn - myLastValueIn);
+
+      myLastValueIn = valueIn;
+      myLastValueOut = valueOut;
+
+      return valueOut;
+    }
 
   private:
 
@@ -71,12 +71,14 @@ LanczosResampler::LanczosResampler(
   // -> we find N from fully reducing the fraction.
   myPrecomputedKernelCount(reducedDenominator(formatFrom.sampleRate, formatTo.sampleRate)),
   myKernelSize(2 * kernelParameter),
+  myKernelSpacing(formatTo.sampleRate / myPrecomputedKernelCount),
   myKernelParameter(kernelParameter),
   myHighPassL(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myHighPassR(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myHighPass(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate))
 {
   myPrecomputedKernels = make_unique<float[]>(myPrecomputedKernelCount * myKernelSize);
+  myKernelIndexForPhase = make_unique<uInt32[]>(myPrecomputedKernelCount);
 
   if (myFormatFrom.stereo)
   {
@@ -97,6 +99,9 @@ void LanczosResampler::precomputeKernels()
 
   for (uInt32 i = 0; i < myPrecomputedKernelCount; ++i) {
     float* kernel = myPrecomputedKernels.get() + myKernelSize * i;
+    // All time indices visited at the nominal rate are multiples of myKernelSpacing
+    myKernelIndexForPhase[timeIndex / myKernelSpacing] = i;
+
     // The kernel is normalized such to be evaluate on time * formatFrom.sampleRate
     float center =
       static_cast<float>(timeIndex) / static_cast<float>(myFormatTo.sampleRate);
@@ -143,34 +148,36 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   for (uInt32 i = 0; i < outputSamples; ++i) {
-    float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
-    myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
+    // If the rate is adjusted, the time index may fall between two precomputed kernels;
+    // we use the preceding one. At the nominal rate, this is exact.
+    const uInt32 phase = uInt32(myTimeIndex >> TIME_INDEX_FRACTION_BITS) / myKernelSpacing;
+    const float* kernel = myPrecomputedKernels.get() + (myKernelIndexForPhase[phase] * myKernelSize);
 
     if (myFormatFrom.stereo) {
       float sampleL = myBufferL->convoluteWith(kernel);
       float sampleR = myBufferR->convoluteWith(kernel);
 
       if (myFormatTo.stereo) {
-        fragment[2*i] = sampleL;
-        fragment[2*i + 1] = sampleR;
+        fragment[2*i] = sampleL * myVolume;
+        fragment[2*i + 1] = sampleR * myVolume;
       }
       else
-        fragment[i] = (sampleL + sampleR) / 2.F;
+        fragment[i] = (sampleL + sampleR) / 2.F * myVolume;
     } else {
       float sample = myBuffer->convoluteWith(kernel);
 
       if (myFormatTo.stereo)
-        fragment[2*i] = fragment[2*i + 1] = sample;
+        fragment[2*i] = fragment[2*i + 1] = sample * myVolume;
       else
-        fragment[i] = sample;
+        fragment[i] = sample * myVolume;
     }
 
-    myTimeIndex += myFormatFrom.sampleRate;
+    myTimeIndex += myTimeIndexIncrement;
 
-    uInt32 samplesToShift = myTimeIndex / myFormatTo.sampleRate;
+    uInt32 samplesToShift = uInt32(myTimeIndex / myTimeIndexModulus);
     if (samplesToShift == 0) continue;
 
-    myTimeIndex %= myFormatTo.sampleRate;
+    myTimeIndex %= myTimeIndexModulus;
     shiftSamples(samplesToShift);
   }
 }
@@ -45,9 +45,13 @@ class LanczosResampler : public Resampler
 
     uInt32 myPrecomputedKernelCount{0};
     uInt32 myKernelSize{0};
-    uInt32 myCurrentKernelIndex{0};
     unique_ptr<float[]> myPrecomputedKernels;
 
+    // The kernels are spaced by this amount of (integral) time index. The kernel
+    // for a given time index is found via the lookup table below.
+    uInt32 myKernelSpacing{1};
+    unique_ptr<uInt32[]> myKernelIndexForPhase;
+
     uInt32 myKernelParameter{0};
 
     unique_ptr<ConvolutionBuffer> myBuffer;
@@ -62,7 +66,7 @@ class LanczosResampler : public Resampler
     HighPass myHighPassR;
     HighPass myHighPass;
 
-    uInt32 myTimeIndex{0};
+    uInt64 myTimeIndex{0};
 };
 
 #endif // LANCZOS_RESAMPLER_HXX
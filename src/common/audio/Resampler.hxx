@@ -19,6 +19,7 @@
 #define RESAMPLER_HXX
 
 #include <functional>
+#include <cmath>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -55,15 +56,39 @@ class Resampler {
       myFormatFrom(formatFrom),
       myFormatTo(formatTo),
       myNextFragmentCallback(nextFragmentCallback),
-      myUnderrunLogger("audio buffer underrun", Logger::Level::INFO)
+      myUnderrunLogger("audio buffer underrun", Logger::Level::INFO),
+      myTimeIndexIncrement(uInt64(formatFrom.sampleRate) << TIME_INDEX_FRACTION_BITS),
+      myTimeIndexModulus(uInt64(formatTo.sampleRate) << TIME_INDEX_FRACTION_BITS)
     {}
 
     virtual void fillFragment(float* fragment, uInt32 length) = 0;
 
+    /**
+      Consume input samples faster (positive) or slower (negative) than
+      nominal by the given amount in parts per million. This allows the sink
+      to keep the fill level of the audio queue constant (dynamic rate control).
+     */
+    void setRateAdjustment(double ppm) {
+      myTimeIndexIncrement = static_cast<uInt64>(std::round(
+        static_cast<double>(uInt64(myFormatFrom.sampleRate) << TIME_INDEX_FRACTION_BITS) *
+        (1. + ppm / 1e6)
+      ));
+    }
+
+    /**
+      Scale the output by the given factor. Volume is applied while the
+      output is written, so the sink doesn't need a separate pass.
+     */
+    void setVolume(float volume) { myVolume = volume; }
+
     virtual ~Resampler() = default;
 
   protected:
 
+    // The time index is kept in fixed point with this many fractional bits.
+    // An integral time index of t corresponds to time = t / (from.sampleRate * to.sampleRate).
+    static constexpr uInt32 TIME_INDEX_FRACTION_BITS = 16;
+
     Format myFormatFrom;
     Format myFormatTo;
 
@@ -71,6 +96,16 @@ class Resampler {
 
     StaggeredLogger myUnderrunLogger;
 
+    // Increment of the time index for each output sample: nominally
+    // from.sampleRate, modified by the rate adjustment
+    uInt64 myTimeIndexIncrement{0};
+
+    // The time index wraps at to.sampleRate (the duration of one input sample)
+    uInt64 myTimeIndexModulus{0};
+
+    // Output volume (0 .. 1)
+    float myVolume{1.F};
+
   private:
 
     Resampler() = delete;
@@ -47,34 +47,35 @@ void SimpleResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   // For the following math, remember that myTimeIndex = time * myFormatFrom.sampleRate * myFormatTo.sampleRate
+  // (in fixed point, see Resampler)
   for (uInt32 i = 0; i < outputSamples; ++i) {
     if (myFormatFrom.stereo) {
       float sampleL = static_cast<float>(myCurrentFragment[2*myFragmentIndex]) / static_cast<float>(0x7fff);
       float sampleR = static_cast<float>(myCurrentFragment[2*myFragmentIndex + 1]) / static_cast<float>(0x7fff);
 
       if (myFormatTo.stereo) {
-        fragment[2*i] = sampleL;
-        fragment[2*i + 1] = sampleR;
+        fragment[2*i] = sampleL * myVolume;
+        fragment[2*i + 1] = sampleR * myVolume;
       }
       else
-        fragment[i] = (sampleL + sampleR) / 2.F;
+        fragment[i] = (sampleL + sampleR) / 2.F * myVolume;
     } else {
       float sample = static_cast<float>(myCurrentFragment[myFragmentIndex] / static_cast<float>(0x7fff));
 
       if (myFormatTo.stereo)
-        fragment[2*i] = fragment[2*i + 1] = sample;
+        fragment[2*i] = fragment[2*i + 1] = sample * myVolume;
       else
-        fragment[i] = sample;
+        fragment[i] = sample * myVolume;
     }
 
     // time += 1 / myFormatTo.sampleRate
-    myTimeIndex += myFormatFrom.sampleRate;
+    myTimeIndex += myTimeIndexIncrement;
 
     // time >= 1 / myFormatFrom.sampleRate
-    if (myTimeIndex >= myFormatTo.sampleRate) {
+    if (myTimeIndex >= myTimeIndexModulus) {
       // myFragmentIndex += time * myFormatFrom.sampleRate
-      myFragmentIndex += myTimeIndex / myFormatTo.sampleRate;
-      myTimeIndex %= myFormatTo.sampleRate;
+      myFragmentIndex += uInt32(myTimeIndex / myTimeIndexModulus);
+      myTimeIndex %= myTimeIndexModulus;
     }
 
     if (myFragmentIndex >= myFormatFrom.fragmentSize) {
@@ -107,6 +107,20 @@ static const string EmptyString("");
   #define ADAPTABLE_REFRESH_SUPPORT
 #endif
 
+// Vector instructions that are part of the baseline instruction set of the
+// target (x86-64 and AArch64), and hence don't need runtime detection
+// BSPF_NO_SIMD selects the scalar code instead (e.g. to compare both)
+#if defined(BSPF_NO_SIMD)
+  // scalar code only
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define BSPF_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define BSPF_NEON
+#endif
+#if defined(BSPF_SSE2) || defined(BSPF_NEON)
+  #define BSPF_SIMD
+#endif
+
 namespace BSPF
 {
   static constexpr float PI_f = 3.141592653589793238462643383279502884F;
@@ -70,7 +70,7 @@ void checkForCustomBaseDir(Settings::Options& options);
 
 /**
   Checks whether the commandline contains an argument corresponding to
-  starting a profile session.
+  starting a profile or regression session.
 */
 bool isProfilingRun(int ac, char* av[]);
 
@@ -150,7 +150,8 @@ void checkForCustomBaseDir(Settings::Options& options)
 bool isProfilingRun(int ac, char* av[]) {
   if (ac <= 1) return false;
 
-  return string(av[1]) == "-profile";
+  return string(av[1]) == "-profile" || string(av[1]) == "-regress" ||
+         string(av[1]) == "-regress-update";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -174,7 +175,7 @@ int main(int ac, char* av[])
     catch(const runtime_error& e)
     {
       cerr << e.what() << endl;
-      return 0;
+      return 1;
     }
   }
 
@@ -295,6 +296,8 @@ int main(int ac, char* av[])
 #endif
   }
 
+  theOSystem->printStartupTimes();
+
   // Start the main loop, and don't exit until the user issues a QUIT command
   Logger::debug("Starting main loop ...");
   theOSystem->mainLoop();
@@ -18,16 +18,22 @@ MODULE_OBJS := \
 	src/common/PKeyboardHandler.o \
 	src/common/PNGLibrary.o \
 	src/common/RewindManager.o \
+	src/common/RomCache.o \
+	src/common/RomIndexer.o \
+	src/common/ThumbnailCache.o \
 	src/common/SoundSDL2.o \
 	src/common/StateManager.o \
 	src/common/TimerManager.o \
 	src/common/ZipHandler.o \
 	src/common/AudioQueue.o \
+	src/common/AudioTelemetry.o \
 	src/common/AudioSettings.o \
 	src/common/FpsMeter.o \
+	src/common/FrameTiming.o \
 	src/common/ThreadDebugging.o \
 	src/common/StaggeredLogger.o \
 	src/common/repository/KeyValueRepositoryConfigfile.o \
+	src/common/repository/KeyValueRepositoryWriteBehind.o \
 	src/common/sdl_blitter/BilinearBlitter.o \
 	src/common/sdl_blitter/QisBlitter.o \
 	src/common/sdl_blitter/BlitterFactory.o \
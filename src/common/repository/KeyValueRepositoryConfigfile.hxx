@@ -32,9 +32,11 @@ class KeyValueRepositoryConfigfile : public KeyValueRepository
 
     void save(const string& key, const Variant& value) override {}
 
+    void remove(const string& key) override {}
+
   private:
 
-    const string& myFilename;
+    const string myFilename;
 };
 
 #endif // KEY_VALUE_REPOSITORY_CONFIGFILE_HXX
@@ -0,0 +1,166 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "KeyValueRepositoryWriteBehind.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryWriteBehind::KeyValueRepositoryWriteBehind(
+  shared_ptr<KeyValueRepository> repository
+) : myRepository(std::move(repository))
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryWriteBehind::~KeyValueRepositoryWriteBehind()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myWakeup.notify_one();
+
+  // The thread saves the pending values before it quits
+  if(myThread.joinable())
+    myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::map<string, Variant> KeyValueRepositoryWriteBehind::load()
+{
+  std::map<string, Variant> values;
+  {
+    std::lock_guard<std::mutex> lock(ourRepositoryMutex);
+    values = myRepository->load();
+  }
+
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Values which haven't been saved yet are newer than the loaded ones
+  for(const auto& pair: myChanged)
+    values[pair.first] = pair.second;
+  for(const auto& key: myRemoved)
+    values.erase(key);
+
+  myValues = values;
+
+  return values;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryWriteBehind::save(const std::map<string, Variant>& values)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  bool changed = false;
+  for(const auto& pair: values)
+  {
+    auto it = myValues.find(pair.first);
+    if(it == myValues.end() || it->second != pair.second)
+    {
+      myValues[pair.first] = myChanged[pair.first] = pair.second;
+      myRemoved.erase(pair.first);
+      changed = true;
+    }
+  }
+  if(!changed)
+    return;
+
+  schedule();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryWriteBehind::save(const string& key, const Variant& value)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  auto it = myValues.find(key);
+  if(it != myValues.end() && it->second == value)
+    return;
+
+  myValues[key] = value;
+  myChanged[key] = value;
+  myRemoved.erase(key);
+
+  schedule();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryWriteBehind::remove(const string& key)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  myValues.erase(key);
+  myChanged.erase(key);
+  myRemoved.insert(key);
+
+  schedule();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryWriteBehind::schedule()
+{
+  // Each change postpones saving, so that a series of changes is saved
+  // together
+  myDeadline = Clock::now() + DELAY;
+
+  // The thread is only started when something has to be saved
+  if(!myThread.joinable())
+    myThread = std::thread(&KeyValueRepositoryWriteBehind::workerLoop, this);
+
+  myWakeup.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryWriteBehind::workerLoop()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  for(;;)
+  {
+    myWakeup.wait(lock, [this] {
+      return myQuit || !myChanged.empty() || !myRemoved.empty();
+    });
+
+    // Wait until there haven't been any changes for a while
+    while(!myQuit && Clock::now() < myDeadline)
+      myWakeup.wait_until(lock, myDeadline);
+
+    if(myChanged.empty() && myRemoved.empty())
+      return;  // quit, nothing left to save
+
+    std::map<string, Variant> values;
+    values.swap(myChanged);
+    std::set<string> removed;
+    removed.swap(myRemoved);
+
+    // Save without holding the lock, so the values can be changed meanwhile
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> repositoryLock(ourRepositoryMutex);
+      for(const auto& key: removed)
+        myRepository->remove(key);
+      if(!values.empty())
+        myRepository->save(values);
+    }
+    lock.lock();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::mutex KeyValueRepositoryWriteBehind::ourRepositoryMutex;
+constexpr std::chrono::milliseconds KeyValueRepositoryWriteBehind::DELAY;
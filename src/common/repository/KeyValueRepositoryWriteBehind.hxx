@@ -0,0 +1,98 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef KEY_VALUE_REPOSITORY_WRITE_BEHIND_HXX
+#define KEY_VALUE_REPOSITORY_WRITE_BEHIND_HXX
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "KeyValueRepository.hxx"
+
+/**
+  A repository which saves the values of another repository in the
+  background, so that saving never blocks the caller.
+
+  Only values which have actually changed are saved (or removed).  They are collected
+  until no value has changed for a short time, and then saved together
+  (within one transaction for a database).  Values which are still pending
+  are saved when the repository is destroyed.
+*/
+class KeyValueRepositoryWriteBehind : public KeyValueRepository
+{
+  public:
+
+    explicit KeyValueRepositoryWriteBehind(shared_ptr<KeyValueRepository> repository);
+
+    ~KeyValueRepositoryWriteBehind() override;
+
+    std::map<string, Variant> load() override;
+
+    void save(const std::map<string, Variant>& values) override;
+
+    void save(const string& key, const Variant& value) override;
+
+    void remove(const string& key) override;
+
+  private:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+      Schedule the changed values to be saved.  The mutex must be locked.
+    */
+    void schedule();
+
+    void workerLoop();
+
+  private:
+
+    // The time without changes after which the changed values are saved
+    static constexpr std::chrono::milliseconds DELAY{500};
+
+    shared_ptr<KeyValueRepository> myRepository;
+
+    std::thread myThread;
+
+    std::mutex myMutex;
+    std::condition_variable myWakeup;
+
+    // All protected by the mutex
+    std::map<string, Variant> myValues;   // all known values
+    std::map<string, Variant> myChanged;  // the values waiting to be saved
+    std::set<string> myRemoved;           // the keys waiting to be removed
+    Clock::time_point myDeadline;
+    bool myQuit{false};
+
+    // Repositories may share a database, so all of them are accessed by
+    // one thread at a time
+    static std::mutex ourRepositoryMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    KeyValueRepositoryWriteBehind() = delete;
+    KeyValueRepositoryWriteBehind(const KeyValueRepositoryWriteBehind&) = delete;
+    KeyValueRepositoryWriteBehind(KeyValueRepositoryWriteBehind&&) = delete;
+    KeyValueRepositoryWriteBehind& operator=(const KeyValueRepositoryWriteBehind&) = delete;
+    KeyValueRepositoryWriteBehind& operator=(KeyValueRepositoryWriteBehind&&) = delete;
+};
+
+#endif // KEY_VALUE_REPOSITORY_WRITE_BEHIND_HXX
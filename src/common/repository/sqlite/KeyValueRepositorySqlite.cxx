@@ -91,6 +91,23 @@ void KeyValueRepositorySqlite::save(const string& key, const Variant& value)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositorySqlite::remove(const string& key)
+{
+  try {
+    myStmtDelete->reset();
+
+    (*myStmtDelete)
+      .bind(1, key.c_str())
+      .step();
+
+    myStmtDelete->reset();
+  }
+  catch (const SqliteError& err) {
+    Logger::info(err.message);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void KeyValueRepositorySqlite::initialize()
 {
@@ -100,4 +117,5 @@ void KeyValueRepositorySqlite::initialize()
 
   myStmtInsert = make_unique<SqliteStatement>(myDb, "INSERT OR REPLACE INTO `" + myTableName + "` VALUES (?, ?)");
   myStmtSelect = make_unique<SqliteStatement>(myDb, "SELECT `key`, `VALUE` FROM `" + myTableName + "`");
+  myStmtDelete = make_unique<SqliteStatement>(myDb, "DELETE FROM `" + myTableName + "` WHERE `key` = ?");
 }
@@ -36,12 +36,16 @@ bool SettingsDb::initialize()
 
     mySettingsRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "settings");
     mySettingsRepository->initialize();
+
+    myRomCacheRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "romcache");
+    myRomCacheRepository->initialize();
   }
   catch (const SqliteError& err) {
     Logger::info("sqlite DB " + myDb->fileName() + " failed to initialize: " + err.message);
 
     myDb.reset();
     mySettingsRepository.reset();
+    myRomCacheRepository.reset();
 
     return false;
   }
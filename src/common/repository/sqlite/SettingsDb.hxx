@@ -32,6 +32,8 @@ class SettingsDb
 
     KeyValueRepository& settingsRepository() const { return *mySettingsRepository; }
 
+    KeyValueRepository& romCacheRepository() const { return *myRomCacheRepository; }
+
   private:
 
     string myDatabaseDirectory;
@@ -39,6 +41,7 @@ class SettingsDb
 
     unique_ptr<SqliteDatabase> myDb;
     unique_ptr<KeyValueRepositorySqlite> mySettingsRepository;
+    unique_ptr<KeyValueRepositorySqlite> myRomCacheRepository;
 };
 
 #endif // SETTINGS_DB_HXX
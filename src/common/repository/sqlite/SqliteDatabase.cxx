@@ -78,6 +78,10 @@ void SqliteDatabase::initialize()
 
   exec("PRAGMA journal_mode=WAL");
 
+  // In WAL mode, this is still safe against corruption, but doesn't
+  // wait for the disk on every commit
+  exec("PRAGMA synchronous=NORMAL");
+
   switch (sqlite3_wal_checkpoint_v2(myHandle, nullptr, SQLITE_CHECKPOINT_TRUNCATE, nullptr, nullptr)) {
     case SQLITE_OK:
       break;
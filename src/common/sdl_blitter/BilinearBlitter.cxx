@@ -79,7 +79,7 @@ void BilinearBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void BilinearBlitter::blit(SDL_Surface& surface)
+void BilinearBlitter::blit(SDL_Surface& surface, const DirtyRows* dirtyRows)
 {
   ASSERT_MAIN_THREAD;
 
@@ -88,9 +88,12 @@ void BilinearBlitter::blit(SDL_Surface& surface)
   SDL_Texture* texture = myTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(myTexture, &mySrcRect, surface.pixels, surface.pitch);
+    markStaleRows(myStaleRows, dirtyRows);
+    markStaleRows(mySecondaryStaleRows, dirtyRows);
+    updateStaleRows(myTexture, mySrcRect, surface, myStaleRows);
     myTexture = mySecondaryTexture;
     mySecondaryTexture = texture;
+    std::swap(myStaleRows, mySecondaryStaleRows);
   }
 
   SDL_RenderCopy(myFB.renderer(), texture, &mySrcRect, &myDstRect);
@@ -137,6 +140,10 @@ void BilinearBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  // New textures must be uploaded completely
+  myStaleRows.assign(mySrcRect.h, true);
+  mySecondaryStaleRows.assign(mySrcRect.h, true);
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
@@ -38,13 +38,16 @@ class BilinearBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, const DirtyRows* dirtyRows) override;
 
   private:
     FrameBufferSDL2& myFB;
 
     SDL_Texture* myTexture{nullptr};
     SDL_Texture* mySecondaryTexture{nullptr};
+
+    // The rows of both (streaming) source textures that are out of date
+    DirtyRows myStaleRows, mySecondaryStaleRows;
     SDL_Rect mySrcRect{0, 0, 0, 0}, myDstRect{0, 0, 0, 0};
     FBSurface::Attributes myAttributes;
 
@@ -35,12 +35,58 @@ class Blitter {
       SDL_Surface* staticData = nullptr
     ) = 0;
 
-    virtual void blit(SDL_Surface& surface) = 0;
+    /**
+      Flags for the rows of a surface that changed since the last blit.
+     */
+    using DirtyRows = vector<bool>;
+
+    /**
+      Blit the surface to the screen.
+
+      @param surface    The surface to blit
+      @param dirtyRows  The rows that changed since the last blit, or nullptr
+                        if the complete surface must be uploaded
+     */
+    virtual void blit(SDL_Surface& surface, const DirtyRows* dirtyRows) = 0;
 
   protected:
 
     Blitter() = default;
 
+    /**
+      Mark the rows that changed as stale in the rows of a texture.
+     */
+    static void markStaleRows(DirtyRows& staleRows, const DirtyRows* dirtyRows)
+    {
+      for(size_t y = 0; y < staleRows.size(); ++y)
+        if(!dirtyRows || (y < dirtyRows->size() && (*dirtyRows)[y]))
+          staleRows[y] = true;
+    }
+
+    /**
+      Upload the stale rows of a streaming texture from the surface, in as
+      few contiguous runs as possible, and mark them as clean.
+     */
+    static void updateStaleRows(SDL_Texture* texture, const SDL_Rect& srcRect,
+                                const SDL_Surface& surface, DirtyRows& staleRows)
+    {
+      const uInt32 height = static_cast<uInt32>(staleRows.size());
+
+      for(uInt32 y = 0; y < height; )
+      {
+        if(!staleRows[y]) { ++y;  continue; }
+
+        uInt32 end = y;
+        while(end < height && staleRows[end])
+          staleRows[end++] = false;
+
+        const SDL_Rect rect{srcRect.x, srcRect.y + Int32(y), srcRect.w, Int32(end - y)};
+        SDL_UpdateTexture(texture, &rect,
+            static_cast<const uInt8*>(surface.pixels) + y * surface.pitch, surface.pitch);
+        y = end;
+      }
+    }
+
   private:
 
     Blitter(const Blitter&) = delete;
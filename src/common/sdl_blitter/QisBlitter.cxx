@@ -88,7 +88,7 @@ void QisBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QisBlitter::blit(SDL_Surface& surface)
+void QisBlitter::blit(SDL_Surface& surface, const DirtyRows* dirtyRows)
 {
   ASSERT_MAIN_THREAD;
 
@@ -97,7 +97,9 @@ void QisBlitter::blit(SDL_Surface& surface)
   SDL_Texture* intermediateTexture = myIntermediateTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(mySrcTexture, &mySrcRect, surface.pixels, surface.pitch);
+    markStaleRows(myStaleRows, dirtyRows);
+    markStaleRows(mySecondaryStaleRows, dirtyRows);
+    updateStaleRows(mySrcTexture, mySrcRect, surface, myStaleRows);
 
     blitToIntermediate();
 
@@ -107,6 +109,7 @@ void QisBlitter::blit(SDL_Surface& surface)
     SDL_Texture* temporary = mySrcTexture;
     mySrcTexture = mySecondarySrcTexture;
     mySecondarySrcTexture = temporary;
+    std::swap(myStaleRows, mySecondaryStaleRows);
   }
 
   SDL_RenderCopy(myFB.renderer(), intermediateTexture, &myIntermediateRect, &myDstRect);
@@ -193,6 +196,10 @@ void QisBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  // New textures must be uploaded completely
+  myStaleRows.assign(mySrcRect.h, true);
+  mySecondaryStaleRows.assign(mySrcRect.h, true);
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
@@ -40,7 +40,7 @@ class QisBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, const DirtyRows* dirtyRows) override;
 
   private:
 
@@ -48,6 +48,9 @@ class QisBlitter : public Blitter {
 
     SDL_Texture* mySrcTexture{nullptr};
     SDL_Texture* mySecondarySrcTexture{nullptr};
+
+    // The rows of both (streaming) source textures that are out of date
+    DirtyRows myStaleRows, mySecondaryStaleRows;
     SDL_Texture* myIntermediateTexture{nullptr};
     SDL_Texture* mySecondaryIntermedateTexture{nullptr};
 
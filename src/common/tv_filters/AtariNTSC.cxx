@@ -19,6 +19,12 @@
 #include "AtariNTSC.hxx"
 #include "PhosphorHandler.hxx"
 
+#if defined(BSPF_SSE2)
+  #include <emmintrin.h>
+#elif defined(BSPF_NEON)
+  #include <arm_neon.h>
+#endif
+
 // blitter related
 #ifndef restrict
   #if defined (__GNUC__)
@@ -86,8 +92,10 @@ void AtariNTSC::generateKernels()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::enableThreading(bool enable)
+void AtariNTSC::enableThreading(bool enable, uInt32 numThreads)
 {
+  stopThreads();
+
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
   if(systemThreads <= 1)
   {
@@ -96,135 +104,168 @@ void AtariNTSC::enableThreading(bool enable)
   }
   else
   {
-    systemThreads = std::max<uInt32>(1, std::min<uInt32>(4, systemThreads - 1));
+    if(numThreads == 0)
+      systemThreads = std::max<uInt32>(1, std::min<uInt32>(AUTO_THREADS, systemThreads - 1));
+    else
+      systemThreads = std::min<uInt32>(numThreads, MAX_THREADS);
 
     myWorkerThreads = systemThreads - 1;
     myTotalThreads  = systemThreads;
 
-    myThreads = make_unique<std::thread[]>(myWorkerThreads);  // NOLINT
+    myThreads.reserve(myWorkerThreads);
+    for(uInt32 i = 0; i < myWorkerThreads; ++i)
+      myThreads.emplace_back([this, i] { workerLoop(i + 1); });
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
-  void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
+void AtariNTSC::stopThreads()
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
   {
-    myThreads[i] = std::thread([=] {
-    rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
+    std::lock_guard<std::mutex> lock(myJobMutex);
+    myStopThreads = true;
   }
-  // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
-
-  // Copy phosphor values into out buffer
-  if(rgb_in != nullptr)
-    memcpy(rgb_out, rgb_in, in_height * out_pitch);
+  myJobStart.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+
+  myThreads.clear();
+  myStopThreads = false;
+
+  // New workers start at generation 0, so they must not see the last job
+  myJobGeneration = 0;
+  myPendingWorkers = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
-  const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
-  void* rgb_out, const uInt32 out_pitch)
+void AtariNTSC::workerLoop(uInt32 threadNum)
 {
-  // Adapt parameters to thread number
-  const uInt32 yStart = in_height * threadNum / numThreads;
-  const uInt32 yEnd = in_height * (threadNum + 1) / numThreads;
-  atari_in += in_width * yStart;
-  rgb_out  = static_cast<char*>(rgb_out) + out_pitch * yStart;
+  uInt32 generation = 0;
 
-  uInt32 const chunk_count = (in_width - 1) / PIXEL_in_chunk;
-
-  for(uInt32 y = yStart; y < yEnd; ++y)
+  for(;;)
   {
-    const uInt8* line_in = atari_in;
-    ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
-    uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
-    ++line_in;
-
-    // shift right by 2 pixel
-    line_out[0] = line_out[1] = 0;
-    line_out += 2;
-
-    for(uInt32 n = chunk_count; n; --n)
     {
-      // order of input and output pixels must not be altered
-      ATARI_NTSC_COLOR_IN(0, line_in[0])
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
-
-      ATARI_NTSC_COLOR_IN(1, line_in[1])
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
-
-      line_in += 2;
-      line_out += 7;
+      std::unique_lock<std::mutex> lock(myJobMutex);
+      myJobStart.wait(lock, [&] {
+        return myStopThreads || myJobGeneration != generation;
+      });
+      if(myStopThreads)
+        return;
+
+      generation = myJobGeneration;
     }
 
-    // finish final pixels
-    ATARI_NTSC_COLOR_IN(0, line_in[0])
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+    renderPart(threadNum);
 
-    ATARI_NTSC_COLOR_IN(1, NTSC_black)
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+    std::lock_guard<std::mutex> lock(myJobMutex);
+    if(--myPendingWorkers == 0)
+      myJobDone.notify_one();
+  }
+}
 
-    line_out += 7;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
+  void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
+{
+  myJob.atari_in = atari_in;
+  myJob.in_width = in_width;
+  myJob.in_height = in_height;
+  myJob.rgb_out = rgb_out;
+  myJob.out_pitch = out_pitch;
+  myJob.rgb_in = rgb_in;
+
+  // Wake up the threads...
+  if(myWorkerThreads > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(myJobMutex);
+      myPendingWorkers = myWorkerThreads;
+      ++myJobGeneration;
+    }
+    myJobStart.notify_all();
+  }
+  // Make the main thread busy too
+  renderPart(0);
+  // ...and wait until they are finished
+  if(myWorkerThreads > 0)
+  {
+    std::unique_lock<std::mutex> lock(myJobMutex);
+    myJobDone.wait(lock, [this] { return myPendingWorkers == 0; });
+  }
+}
 
-    ATARI_NTSC_COLOR_IN(0, NTSC_black)
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderPart(uInt32 threadNum)
+{
+  const RenderJob& job = myJob;
 
-    ATARI_NTSC_COLOR_IN(1, NTSC_black)
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-#if 0
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
-#endif
+  renderThread(job.atari_in, job.in_width, job.in_height, myTotalThreads,
+               threadNum, job.rgb_in, job.rgb_out, job.out_pitch);
+}
 
-    atari_in += in_width;
-    rgb_out = static_cast<char*>(rgb_out) + out_pitch;
-  }
+#ifdef BSPF_SIMD
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::rgbOut4(const uInt32* k0, const uInt32* k1,
+                        const uInt32* kx0, const uInt32* kx1, uInt32* out)
+{
+  // Same as ATARI_NTSC_RGB_OUT_8888 and ATARI_NTSC_CLAMP, for four pixels
+#if defined(BSPF_SSE2)
+  __m128i raw = _mm_add_epi32(
+    _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(k0)),
+                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(k1))),
+    _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kx0)),
+                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(kx1))));
+
+  const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9),
+                                    _mm_set1_epi32(atari_ntsc_clamp_mask));
+  __m128i clamp = _mm_sub_epi32(_mm_set1_epi32(atari_ntsc_clamp_add), sub);
+  raw = _mm_or_si128(raw, clamp);
+  clamp = _mm_sub_epi32(clamp, sub);
+  raw = _mm_and_si128(raw, clamp);
+
+  const __m128i rgb = _mm_or_si128(
+    _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+    _mm_or_si128(
+      _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00)),
+      _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF))));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), rgb);
+#elif defined(BSPF_NEON)
+  uint32x4_t raw = vaddq_u32(vaddq_u32(vld1q_u32(k0), vld1q_u32(k1)),
+                             vaddq_u32(vld1q_u32(kx0), vld1q_u32(kx1)));
+
+  const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw, 9),
+                                   vdupq_n_u32(atari_ntsc_clamp_mask));
+  uint32x4_t clamp = vsubq_u32(vdupq_n_u32(atari_ntsc_clamp_add), sub);
+  raw = vorrq_u32(raw, clamp);
+  clamp = vsubq_u32(clamp, sub);
+  raw = vandq_u32(raw, clamp);
+
+  const uint32x4_t rgb = vorrq_u32(
+    vandq_u32(vshrq_n_u32(raw, 5), vdupq_n_u32(0x00FF0000)),
+    vorrq_u32(vandq_u32(vshrq_n_u32(raw, 3), vdupq_n_u32(0x0000FF00)),
+              vandq_u32(vshrq_n_u32(raw, 1), vdupq_n_u32(0x000000FF))));
+  vst1q_u32(out, rgb);
+#endif
 }
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
+void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
   const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
   uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch)
 {
-  // Adapt parameters to thread number
-  const uInt32 yStart = in_height * threadNum / numThreads;
-  const uInt32 yEnd = in_height * (threadNum + 1) / numThreads;
-  uInt32 bufofs = AtariNTSC::outWidth(in_width) * yStart;
-  uInt32* out = static_cast<uInt32*>(rgb_out);
-  atari_in += in_width * yStart;
-  rgb_out = static_cast<char*>(rgb_out) + out_pitch * yStart;
-
   uInt32 const chunk_count = (in_width - 1) / PIXEL_in_chunk;
+  uInt32 const out_width = AtariNTSC::outWidth(in_width);
 
-  for(uInt32 y = yStart; y < yEnd; ++y)
+  // Rows are interleaved between the threads
+  for(uInt32 y = threadNum; y < in_height; y += numThreads)
   {
-    const uInt8* line_in = atari_in;
+    const uInt8* line_in = atari_in + in_width * y;
     ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
-    uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
+    uInt32* const row_out =
+      reinterpret_cast<uInt32*>(static_cast<char*>(rgb_out) + out_pitch * y);
+    uInt32* restrict line_out = row_out;
     ++line_in;
 
     // shift right by 2 pixel
@@ -234,6 +275,14 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     for(uInt32 n = chunk_count; n; --n)
     {
       // order of input and output pixels must not be altered
+    #ifdef BSPF_SIMD
+      ATARI_NTSC_COLOR_IN(0, line_in[0])
+      ATARI_NTSC_RGB_OUT_8888_X4(0, line_out[0])
+
+      // line_out[7] is overwritten by the next chunk or the final pixels
+      ATARI_NTSC_COLOR_IN(1, line_in[1])
+      ATARI_NTSC_RGB_OUT_8888_X4(4, line_out[4])
+    #else
       ATARI_NTSC_COLOR_IN(0, line_in[0])
       ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
       ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
@@ -244,6 +293,7 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
       ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
       ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
       ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+    #endif
 
       line_in += 2;
       line_out += 7;
@@ -276,49 +326,11 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
 #endif
 
-    // Do phosphor mode (blend the resulting frames)
-    // Note: The unrolled code assumed that AtariNTSC::outWidth(kTIAW) == outPitch == 565
-    // Now this got changed to 568 so the final 5 calculations got removed.
-    for (uInt32 x = AtariNTSC::outWidth(in_width) / 8; x; --x)
-    {
-      // Store back into displayed frame buffer (for next frame)
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-    }
-    // finish final 565 % 8 = 5 pixels
-    /*rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;*/
-#if 0
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-#endif
-
-    atari_in += in_width;
-    rgb_out = static_cast<char*>(rgb_out) + out_pitch;
+    // Do phosphor mode: blend the row with the previous frame while it is
+    // still in the cache, and store the result both in the output and in
+    // the phosphor buffer (for next frame)
+    if(rgb_in != nullptr)
+      PhosphorHandler::blendRow(row_out, rgb_in + out_width * y, row_out, out_width);
   }
 }
 
@@ -596,6 +608,10 @@ AtariNTSC::atari_ntsc_pixels = { {
   { PIXEL_OFFSET1( 0, -5), PIXEL_OFFSET2( 0), {            1, 1, 1, 1 } }
 } };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+constexpr uInt32 AtariNTSC::AUTO_THREADS;
+constexpr uInt32 AtariNTSC::MAX_THREADS;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const std::array<float, 6> AtariNTSC::default_decoder = {
   0.9563F, 0.6210F, -0.2721F, -0.6474F, -1.1070F, 1.7046F
@@ -42,6 +42,8 @@
 
 #include <cmath>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "FrameBufferConstants.hxx"
 #include "bspf.hxx"
@@ -53,6 +55,7 @@ class AtariNTSC
   public:
     // By default, threading is turned off and palette is blank
     AtariNTSC() { enableThreading(false); myRGBPalette.fill(0); }
+    ~AtariNTSC() { stopThreads(); }
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -90,13 +93,16 @@ class AtariNTSC
     // Set palette for normal Blarrg mode
     void setPalette(const PaletteArray& palette);
 
-    // Set up threading
-    void enableThreading(bool enable);
+    // Set up threading; the number of threads is chosen automatically
+    // when numThreads is zero
+    void enableThreading(bool enable, uInt32 numThreads = 0);
 
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
     // palette colors.
     //  In_row_width is the number of pixels to get to the next input row.
     //  Out_pitch is the number of *bytes* to get to the next output row.
+    //  Rgb_in is the phosphor buffer (outWidth(in_width) pixels per row);
+    //  if present, the output is blended with it in the same pass.
     void render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
                 void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in = nullptr);
 
@@ -111,11 +117,21 @@ class AtariNTSC
     // Generate kernels from raw RGB palette
     void generateKernels();
 
-    // Threaded rendering
+    // Threaded rendering; each thread renders every numThreads'th row,
+    // starting at row threadNum.  In phosphor mode (rgb_in != nullptr),
+    // each row is blended right after it has been generated.
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
-      const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
-    void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
-      const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
+      const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
+      uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
+
+    // Render the part of the current frame assigned to the given thread
+    void renderPart(uInt32 threadNum);
+
+    // Main loop of the worker threads; they are parked between frames
+    void workerLoop(uInt32 threadNum);
+
+    // Terminate and join the worker threads
+    void stopThreads();
 
   private:
     static constexpr Int32
@@ -162,11 +178,33 @@ class AtariNTSC
     std::array<uInt8, palette_size*3> myRGBPalette;
     BSPF::array2D<uInt32, palette_size, entry_size> myColorTable;
 
-    // Rendering threads
-    unique_ptr<std::thread[]> myThreads;  // NOLINT
+    // Maximum number of threads chosen automatically, and in total
+    static constexpr uInt32 AUTO_THREADS = 8, MAX_THREADS = 32;
+
+    // Rendering threads (persistent, woken once per frame)
+    vector<std::thread> myThreads;
     // Number of rendering and total threads
     uInt32 myWorkerThreads{0}, myTotalThreads{0};
 
+    // The frame currently rendered by the threads
+    struct RenderJob
+    {
+      const uInt8* atari_in{nullptr};
+      uInt32 in_width{0}, in_height{0};
+      void* rgb_out{nullptr};
+      uInt32 out_pitch{0};
+      uInt32* rgb_in{nullptr};
+    };
+    RenderJob myJob;
+
+    // Synchronization of the worker threads: a new frame is signalled by
+    // incrementing the generation, the end of the frame by the number of
+    // pending workers dropping to zero
+    std::mutex myJobMutex;
+    std::condition_variable myJobStart, myJobDone;
+    uInt32 myJobGeneration{0}, myPendingWorkers{0};
+    bool myStopThreads{false};
+
     struct init_t
     {
       std::array<float, burst_count * 6> to_rgb{0.F};
@@ -231,6 +269,20 @@ class AtariNTSC
       rgb_out = (raw_>>5 & 0x00FF0000)|(raw_>>3 & 0x0000FF00)|(raw_>>1 & 0x000000FF);\
     }
 
+  #ifdef BSPF_SIMD
+    // Generates four adjacent pixels in the same format, starting at the
+    // given index (0 or 4).  The kernel entries of the four pixels are
+    // contiguous, so they can be processed in parallel.  When starting at
+    // index 4, the fourth pixel is garbage and must be overwritten later.
+    #define ATARI_NTSC_RGB_OUT_8888_X4( index, rgb_out ) {\
+      rgbOut4(kernel0 + (index), kernel1 + (index+10)%7+14,\
+              kernelx0 + (index+7)%14, kernelx1 + (index+3)%7+14+7, &(rgb_out));\
+    }
+
+    static void rgbOut4(const uInt32* k0, const uInt32* k1,
+                        const uInt32* kx0, const uInt32* kx1, uInt32* out);
+  #endif
+
     // Common ntsc macros
     static inline constexpr void ATARI_NTSC_CLAMP( uInt32& io, uInt32 shift ) {
       uInt32 sub = io >> (9-(shift)) & atari_ntsc_clamp_mask;
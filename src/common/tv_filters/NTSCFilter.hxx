@@ -122,10 +122,10 @@ class NTSCFilter
       myNTSC.render(src_buf, src_width, src_height, dest_buf, dest_pitch, prev_buf);
     }
 
-    // Enable threading for the NTSC rendering
-    inline void enableThreading(bool enable)
+    // Enable threading for the NTSC rendering (0 threads = automatic)
+    inline void enableThreading(bool enable, uInt32 numThreads = 0)
     {
-      myNTSC.enableThreading(enable);
+      myNTSC.enableThreading(enable, numThreads);
     }
 
   private:
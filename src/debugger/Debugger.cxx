@@ -103,14 +103,26 @@ void Debugger::initialize()
 
   myOSystem.settings().setValue("dbg.res", Common::Size(myWidth, myHeight));
 
+  // The dialog (and its fonts) is only created when the debugger is used
   delete myDialog;  myDialog = nullptr;
-  myDialog = new DebuggerDialog(myOSystem, *this, 0, 0, myWidth, myHeight);
-
-  myCartDebug->setDebugWidget(&(myDialog->cartDebug()));
+  myCartDebug->setDebugWidget(nullptr);
 
   saveOldState();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DebuggerDialog& Debugger::debuggerDialog() const
+{
+  if(myDialog == nullptr)
+  {
+    myDialog = new DebuggerDialog(myOSystem, const_cast<Debugger&>(*this),
+                                  0, 0, myWidth, myHeight);
+    myCartDebug->setDebugWidget(&(myDialog->cartDebug()));
+    myCartDebug->saveOldState();
+  }
+  return *myDialog;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FBInitStatus Debugger::initializeVideo()
 {
@@ -130,7 +142,7 @@ bool Debugger::start(const string& message, int address, bool read)
     buf << message;
     if(address > -1)
       buf << cartDebug().getLabel(address, read, 4);
-    myDialog->message().setText(buf.str());
+    debuggerDialog().message().setText(buf.str());
     return true;
   }
   return false;
@@ -143,7 +155,7 @@ bool Debugger::startWithFatalError(const string& message)
   {
     // This must be done *after* we enter debug mode,
     // so the dialog is properly shown
-    myDialog->showFatalMessage(message);
+    debuggerDialog().showFatalMessage(message);
     return true;
   }
   return false;
@@ -580,8 +592,11 @@ void Debugger::nextFrame(int frames)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::updateRewindbuttons(const RewindManager& r)
 {
-  myDialog->rewindButton().setEnabled(!r.atFirst());
-  myDialog->unwindButton().setEnabled(!r.atLast());
+  if(myDialog != nullptr)
+  {
+    myDialog->rewindButton().setEnabled(!r.atFirst());
+    myDialog->unwindButton().setEnabled(!r.atLast());
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -675,6 +690,9 @@ void Debugger::setStartState()
   // Lock the bus each time the debugger is entered, so we don't disturb anything
   lockSystem();
 
+  // Set the 're-disassemble' flag, but don't do it until the next scheduled time
+  debuggerDialog().rom().invalidate(false);
+
   // Save initial state and add it to the rewind list (except when in currently rewinding)
   RewindManager& r = myOSystem.state().rewindManager();
   // avoid invalidating future states when entering the debugger e.g. during rewind
@@ -683,15 +701,13 @@ void Debugger::setStartState()
     addState("enter debugger");
   else
     updateRewindbuttons(r);
-
-  // Set the 're-disassemble' flag, but don't do it until the next scheduled time
-  myDialog->rom().invalidate(false);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::setQuitState()
 {
-  myDialog->saveConfig();
+  if(myDialog != nullptr)
+    myDialog->saveConfig();
   saveOldState();
 
   // Bus must be unlocked for normal operation when leaving debugger mode
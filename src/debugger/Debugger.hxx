@@ -124,7 +124,7 @@ class Debugger : public DialogContainer
     /**
       The dialog/GUI associated with the debugger
     */
-    Dialog& dialog() const { return *myDialog; }
+    Dialog& dialog() const { return debuggerDialog(); }
 
     /**
       The debugger subsystem responsible for all CPU state
@@ -146,12 +146,12 @@ class Debugger : public DialogContainer
     */
     TIADebug& tiaDebug() const { return *myTiaDebug; }
 
-    const GUI::Font& lfont() const      { return myDialog->lfont();     }
-    const GUI::Font& nlfont() const     { return myDialog->nfont();     }
-    DebuggerParser& parser() const      { return *myParser;             }
-    PromptWidget& prompt() const        { return myDialog->prompt();    }
-    RomWidget& rom() const              { return myDialog->rom();       }
-    TiaOutputWidget& tiaOutput() const  { return myDialog->tiaOutput(); }
+    const GUI::Font& lfont() const      { return debuggerDialog().lfont();     }
+    const GUI::Font& nlfont() const     { return debuggerDialog().nfont();     }
+    DebuggerParser& parser() const      { return *myParser;                    }
+    PromptWidget& prompt() const        { return debuggerDialog().prompt();    }
+    RomWidget& rom() const              { return debuggerDialog().rom();       }
+    TiaOutputWidget& tiaOutput() const  { return debuggerDialog().tiaOutput(); }
 
     BreakpointMap& breakPoints() const;
 
@@ -280,11 +280,17 @@ class Debugger : public DialogContainer
     /**
       Return (and possibly create) the bottom-most dialog of this container.
     */
-    Dialog* baseDialog() override { return myDialog; }
+    Dialog* baseDialog() override { return &debuggerDialog(); }
 
     static const Int32 NOT_FOUND = -1;
 
   private:
+    /**
+      The dialog of the debugger, which is created (along with its fonts)
+      the first time it is needed.
+    */
+    DebuggerDialog& debuggerDialog() const;
+
     /**
       Save state of each debugger subsystem and, by default, mark all
       pages as clean (ie, turn off the dirty flag).
@@ -339,7 +345,8 @@ class Debugger : public DialogContainer
     Console& myConsole;
     System&  mySystem;
 
-    DebuggerDialog* myDialog{nullptr};
+    // Created on first use, see debuggerDialog()
+    mutable DebuggerDialog* myDialog{nullptr};
     unique_ptr<DebuggerParser> myParser;
     unique_ptr<CartDebug>      myCartDebug;
     unique_ptr<CpuDebug>       myCpuDebug;
@@ -24,6 +24,7 @@
 #include "RiotDebug.hxx"
 #include "ControlLowLevel.hxx"
 #include "TIADebug.hxx"
+#include "TIA.hxx"
 #include "TiaOutputWidget.hxx"
 #include "DebuggerParser.hxx"
 #include "YaccParser.hxx"
@@ -39,6 +40,7 @@
 #include "Vec.hxx"
 
 #include "Base.hxx"
+#include "XXH64.hxx"
 using Common::Base;
 using std::hex;
 using std::dec;
@@ -1263,6 +1265,19 @@ void DebuggerParser::executeFrame()
   commandResult << "advanced " << dec << count << " frame(s)";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "framehash"
+void DebuggerParser::executeFrameHash()
+{
+  const TIA& tia = debugger.tiaDebug().tia();
+
+  commandResult << "frame " << dec << tia.frameCount() << ": "
+                << XXH64::toString(tia.frameHash());
+  if(tia.hashingEnabled())
+    commandResult << endl << "video: " << XXH64::toString(tia.videoHash())
+                  << ", audio: " << XXH64::toString(tia.audioHash());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "function"
 void DebuggerParser::executeFunction()
@@ -2314,7 +2329,7 @@ void DebuggerParser::executeZ()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // List of all commands available to the parser
-std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
+std::array<DebuggerParser::Command, 101> DebuggerParser::commands = { {
   {
     "a",
     "Set Accumulator to <value>",
@@ -2641,6 +2656,17 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeFrame)
   },
 
+  {
+    "framehash",
+    "Show hash of last completed frame",
+    "Also shows hashes of all video/audio since reset,\n"
+    "if enabled with -framehash\nExample: framehash",
+    false,
+    false,
+    { Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeFrameHash)
+  },
+
   {
     "function",
     "Define function name xx for expression yy",
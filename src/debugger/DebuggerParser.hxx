@@ -98,7 +98,7 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    static std::array<Command, 100> commands;
+    static std::array<Command, 101> commands;
 
     struct Trap
     {
@@ -176,6 +176,7 @@ class DebuggerParser
     void executeExec();
     void executeExitRom();
     void executeFrame();
+    void executeFrameHash();
     void executeFunction();
     void executeGfx();
     void executeHelp();
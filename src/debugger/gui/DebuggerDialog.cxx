@@ -65,9 +65,6 @@ DebuggerDialog::DebuggerDialog(OSystem& osystem, DialogContainer& parent,
 
   // Inform the TIA output widget about its associated zoom widget
   myTiaOutput->setZoomWidget(myTiaZoom);
-
-  myOptions = make_unique<OptionsDialog>(osystem, parent, this, w, h,
-                                         Menu::AppMode::debugger);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -252,6 +249,9 @@ void DebuggerDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kDDOptionsCmd:
       saveConfig();
+      if(myOptions == nullptr)
+        myOptions = make_unique<OptionsDialog>(instance(), parent(), this, _w, _h,
+                                               Menu::AppMode::debugger);
       myOptions->open();
       loadConfig();
       break;
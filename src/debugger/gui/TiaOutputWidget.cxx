@@ -178,7 +178,9 @@ void TiaOutputWidget::drawWidget(bool hilite)
   uInt32 scanx, scany, scanoffset;
   bool visible = instance().console().tia().electronBeamPos(scanx, scany);
   scanoffset = width * scany + scanx;
-  uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  // Below the beam, the previous frame is shown (greyed out)
+  const uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  const uInt8* tiaLastFrame = instance().console().tia().lastFrameBuffer();
   const TIASurface& tiaSurface = instance().frameBuffer().tiaSurface();
 
   for(uInt32 y = 0, i = yStart * width; y < height; ++y)
@@ -187,7 +189,7 @@ void TiaOutputWidget::drawWidget(bool hilite)
     for(uInt32 x = 0; x < width; ++x, ++i)
     {
       uInt8 shift = i >= scanoffset ? 1 : 0;
-      uInt32 pixel = tiaSurface.mapIndexedPixel(tiaOutputBuffer[i], shift);
+      uInt32 pixel = tiaSurface.mapIndexedPixel(shift ? tiaLastFrame[i] : tiaOutputBuffer[i], shift);
       *line_ptr++ = pixel;
       *line_ptr++ = pixel;
     }
@@ -295,6 +295,7 @@ void TiaZoomWidget::drawWidget(bool hilite)
   // This probably isn't as efficient as it can be, but it's a small area
   // and I don't have time to make it faster :)
   const uInt8* currentFrame  = instance().console().tia().outputBuffer();
+  const uInt8* lastFrame     = instance().console().tia().lastFrameBuffer();
   const int width = instance().console().tia().width(),
             wzoom = myZoomLevel << 1,
             hzoom = myZoomLevel;
@@ -311,7 +312,7 @@ void TiaZoomWidget::drawWidget(bool hilite)
     for(x = myOffX >> 1, col = 0; x < (myNumCols+myOffX) >> 1; ++x, col += wzoom)
     {
       uInt32 idx = y*width + x;
-      ColorId color = ColorId(currentFrame[idx] | (idx > scanoffset ? 1 : 0));
+      ColorId color = idx > scanoffset ? ColorId(lastFrame[idx] | 1) : ColorId(currentFrame[idx]);
       s.fillRect(_x + col + 1, _y + row + 1, wzoom, hzoom, color);
     }
   }
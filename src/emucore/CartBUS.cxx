@@ -82,8 +82,8 @@ void CartridgeBUS::reset()
   initializeStartBank(6);
 
   // Update cycles to the current system cycles
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myARMCycles = 0;
+  myMusicOscillator.reset();
 
   setInitialState();
 
@@ -137,19 +137,9 @@ void CartridgeBUS::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeBUS::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
+  // Let's update counters of the music mode data fetchers
+  MusicOscillator::advance(myMusicCounters, myMusicFrequencies,
+                           myMusicOscillator.update(mySystem->cycles()));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -559,9 +549,8 @@ bool CartridgeBUS::save(Serializer& out) const
     out.putShort(mySTYZeroPageAddress);
     out.putShort(myJMPoperandAddress);
 
-    // Save cycles and clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    // The music oscillator
+    if(!myMusicOscillator.save(out)) return false;
     out.putLong(myARMCycles);
 
     // Audio info
@@ -600,9 +589,8 @@ bool CartridgeBUS::load(Serializer& in)
     mySTYZeroPageAddress = in.getShort();
     myJMPoperandAddress = in.getShort();
 
-    // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // The music oscillator
+    if(!myMusicOscillator.load(in)) return false;
     myARMCycles = in.getLong();
 
     // Audio info
@@ -26,6 +26,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicOscillator.hxx"
 
 /**
   Cartridge class used for BUS.
@@ -247,9 +248,6 @@ class CartridgeBUS : public Cartridge
     // *and* the next two bytes in ROM are 00 00
     uInt16 myJMPoperandAddress{0};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles{0};
 
@@ -262,8 +260,8 @@ class CartridgeBUS : public Cartridge
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // The music oscillator, clocking the music data fetchers
+    MusicOscillator myMusicOscillator;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
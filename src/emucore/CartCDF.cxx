@@ -98,8 +98,8 @@ void CartridgeCDF::reset()
   // CDF always starts in bank 6
   initializeStartBank(6);
 
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myARMCycles = 0;
+  myMusicOscillator.reset();
 
   setInitialState();
 
@@ -147,19 +147,9 @@ void CartridgeCDF::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeCDF::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of CDF OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
+  // Let's update counters of the music mode data fetchers
+  MusicOscillator::advance(myMusicCounters, myMusicFrequencies,
+                           myMusicOscillator.update(mySystem->cycles()));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -515,9 +505,8 @@ bool CartridgeCDF::save(Serializer& out) const
     out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     out.putByteArray(myMusicWaveformSize.data(), myMusicWaveformSize.size());
 
-    // Save cycles and clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    // The music oscillator
+    if(!myMusicOscillator.save(out)) return false;
     out.putLong(myARMCycles);
   }
   catch(...)
@@ -555,9 +544,8 @@ bool CartridgeCDF::load(Serializer& in)
     in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     in.getByteArray(myMusicWaveformSize.data(), myMusicWaveformSize.size());
 
-    // Get cycles and clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // The music oscillator
+    if(!myMusicOscillator.load(in)) return false;
     myARMCycles = in.getLong();
   }
   catch(...)
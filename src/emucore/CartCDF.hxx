@@ -23,6 +23,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicOscillator.hxx"
 
 /**
   Cartridge class used for CDF.
@@ -237,9 +238,6 @@ class CartridgeCDF : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles{0};
 
@@ -268,8 +266,8 @@ class CartridgeCDF : public Cartridge
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // The music oscillator, clocking the music data fetchers
+    MusicOscillator myMusicOscillator;
 
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
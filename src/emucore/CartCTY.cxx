@@ -18,7 +18,6 @@
 #include "OSystem.hxx"
 #include "Serializer.hxx"
 #include "System.hxx"
-#include "TimerManager.hxx"
 #include "CartCTY.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,8 +55,7 @@ void CartridgeCTY::reset()
   myRandomNumber = 0x2B435044;
   myRamAccessTimeout = 0;
 
-  myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusicOscillator.reset();
 
   // Upon reset we switch to the startup bank
   bank(startBank());
@@ -297,8 +295,7 @@ bool CartridgeCTY::save(Serializer& out) const
     out.putShort(myTunePosition);
     out.putBool(myLDAimmediate);
     out.putInt(myRandomNumber);
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    if(!myMusicOscillator.save(out)) return false;
     out.putIntArray(myMusicCounters.data(), myMusicCounters.size());
     out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     out.putLong(myFrequencyImage - myTuneData.data()); // FIXME - storing pointer diff!
@@ -325,8 +322,7 @@ bool CartridgeCTY::load(Serializer& in)
     myTunePosition = in.getShort();
     myLDAimmediate = in.getBool();
     myRandomNumber = in.getInt();
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    if(!myMusicOscillator.load(in)) return false;
     in.getIntArray(myMusicCounters.data(), myMusicCounters.size());
     in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
     myFrequencyImage = myTuneData.data() + in.getLong();
@@ -379,7 +375,7 @@ uInt8 CartridgeCTY::ramReadWrite()
         if(index < 7)
         {
           // Add 0.5 s delay for read
-          myRamAccessTimeout = TimerManager::getTicks() + 500000;
+          myRamAccessTimeout = mySystem->cycles() + uInt64(500000000.0 / 838.0);
           loadTune(index);
         }
         break;
@@ -387,7 +383,7 @@ uInt8 CartridgeCTY::ramReadWrite()
         if(index < 4)
         {
           // Add 0.5 s delay for read
-          myRamAccessTimeout = TimerManager::getTicks() + 500000;
+          myRamAccessTimeout = mySystem->cycles() + uInt64(500000000.0 / 838.0);
           loadScore(index);
         }
         break;
@@ -395,13 +391,13 @@ uInt8 CartridgeCTY::ramReadWrite()
         if(index < 4)
         {
           // Add 1 s delay for write
-          myRamAccessTimeout = TimerManager::getTicks() + 1000000;
+          myRamAccessTimeout = mySystem->cycles() + uInt64(1000000000.0 / 838.0);
           saveScore(index);
         }
         break;
       case 4:  // Wipe all score tables
         // Add 1 s delay for write
-        myRamAccessTimeout = TimerManager::getTicks() + 1000000;
+        myRamAccessTimeout = mySystem->cycles() + uInt64(1000000000.0 / 838.0);
         wipeAllScores();
         break;
     }
@@ -411,7 +407,7 @@ uInt8 CartridgeCTY::ramReadWrite()
   else
   {
     // Have we reached the timeout value yet?
-    if(TimerManager::getTicks() >= myRamAccessTimeout)
+    if(mySystem->cycles() >= myRamAccessTimeout)
     {
       myRamAccessTimeout = 0;  // Turn off timer
       myRAM[0] = 0;            // Successful operation
@@ -567,19 +563,9 @@ void CartridgeCTY::wipeAllScores()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeCTY::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of CTY OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
+  // Let's update counters of the music mode data fetchers
+  MusicOscillator::advance(myMusicCounters, myMusicFrequencies,
+                           myMusicOscillator.update(mySystem->cycles()));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
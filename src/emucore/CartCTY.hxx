@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicOscillator.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartCTYWidget.hxx"
 #endif
@@ -293,7 +294,7 @@ class CartridgeCTY : public Cartridge
     // The random number generator register
     uInt32 myRandomNumber{0x2B435044};
 
-    // The time after which the first request of a load/save operation
+    // The CPU cycle after which the first request of a load/save operation
     // will actually be completed
     // Due to Harmony EEPROM constraints, a read/write isn't instantaneous,
     // so we need to emulate the delay as well
@@ -303,11 +304,8 @@ class CartridgeCTY : public Cartridge
     // of internal RAM to Harmony cart EEPROM
     string myEEPROMFile;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // The music oscillator, clocking the music data fetchers
+    MusicOscillator myMusicOscillator;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
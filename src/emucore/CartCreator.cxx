@@ -71,7 +71,7 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge> CartCreator::create(const FilesystemNode& file,
     const ByteBuffer& image, size_t size, string& md5,
-    const string& propertiesType, Settings& settings)
+    const string& propertiesType, string& autodetected, Settings& settings)
 {
   unique_ptr<Cartridge> cartridge;
   Bankswitch::Type type = Bankswitch::nameToType(propertiesType),
@@ -91,7 +91,13 @@ unique_ptr<Cartridge> CartCreator::create(const FilesystemNode& file,
   // If we ask for extended info, always do an autodetect
   if(type == Bankswitch::Type::_AUTO || settings.getBool("rominfo"))
   {
-    detectedType = CartDetector::autodetectType(image, size);
+    if(autodetected != EmptyString && !settings.getBool("rominfo"))
+      detectedType = Bankswitch::nameToType(autodetected);
+    else
+    {
+      detectedType = CartDetector::autodetectType(image, size);
+      autodetected = Bankswitch::typeToName(detectedType);
+    }
     if(type != Bankswitch::Type::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
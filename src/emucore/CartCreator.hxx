@@ -42,12 +42,15 @@ class CartCreator
       @param size     The size of the ROM image
       @param md5      The md5sum for the given ROM image (can be updated)
       @param dtype    The detected bankswitch type of the ROM image
+      @param autodetected  A previously autodetected type of the ROM image,
+                           used instead of autodetecting it again; when empty,
+                           it is set to the autodetected type (if any)
       @param settings The settings container
       @return   Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge> create(const FilesystemNode& file,
                  const ByteBuffer& image, size_t size, string& md5,
-                 const string& dtype, Settings& settings);
+                 const string& dtype, string& autodetected, Settings& settings);
 
   private:
     /**
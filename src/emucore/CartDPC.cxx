@@ -33,9 +33,8 @@ void CartridgeDPC::reset()
 {
   CartridgeEnhanced::reset();
 
-  myAudioCycles = 0;
-  myFractionalClocks = 0.0;
-  myDpcPitch = mySettings.getInt(AudioSettings::SETTING_DPC_PITCH);
+  myMusicOscillator.reset();
+  myMusicOscillator.setPitch(mySettings.getInt(AudioSettings::SETTING_DPC_PITCH));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -77,14 +76,8 @@ inline void CartridgeDPC::clockRandomNumberGenerator()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPC::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of DPC OSC clocks since the last update
-  double clocks = ((myDpcPitch * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myMusicOscillator.update(mySystem->cycles());
 
   if(wholeClocks <= 0)
     return;
@@ -362,8 +355,8 @@ bool CartridgeDPC::save(Serializer& out) const
     // The random number generator register
     out.putByte(myRandomNumber);
 
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    // The music oscillator
+    if(!myMusicOscillator.save(out)) return false;
   }
   catch(...)
   {
@@ -401,9 +394,8 @@ bool CartridgeDPC::load(Serializer& in)
     // The random number generator register
     myRandomNumber = in.getByte();
 
-    // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // The music oscillator
+    if(!myMusicOscillator.load(in)) return false;
   }
   catch(...)
   {
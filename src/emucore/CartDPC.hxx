@@ -19,6 +19,7 @@
 #define CARTRIDGE_DPC_HXX
 
 #include "CartF8.hxx"
+#include "MusicOscillator.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartDPCWidget.hxx"
 #endif
@@ -103,7 +104,7 @@ class CartridgeDPC : public CartridgeF8
 
       @param pitch  The new pitch value
     */
-    void setDpcPitch(double pitch) { myDpcPitch = pitch; }
+    void setDpcPitch(uInt32 pitch) { myMusicOscillator.setPitch(pitch); }
 
   #ifdef DEBUGGER_SUPPORT
     /**
@@ -168,14 +169,8 @@ class CartridgeDPC : public CartridgeF8
     // The random number generator register
     uInt8 myRandomNumber{1};  // DPC's RNG register (must be non-zero)
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
-
-    // DPC pitch
-    double myDpcPitch{0.0};
+    // The music oscillator, clocking the music data fetchers
+    MusicOscillator myMusicOscillator;
 
   private:
     // Following constructors and assignment operators not supported
@@ -112,8 +112,8 @@ void CartridgeDPCPlus::setInitialState()
 
   // Initialize various other parameters
   myFastFetch = myLDAimmediate = false;
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myARMCycles = 0;
+  myMusicOscillator.reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -156,19 +156,9 @@ inline void CartridgeDPCPlus::priorClockRandomNumberGenerator()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
+  // Let's update counters of the music mode data fetchers
+  MusicOscillator::advance(myMusicCounters, myMusicFrequencies,
+                           myMusicOscillator.update(mySystem->cycles()));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -691,9 +681,8 @@ bool CartridgeDPCPlus::save(Serializer& out) const
     // The random number generator register
     out.putInt(myRandomNumber);
 
-    // Get system cycles and fractional clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    // The music oscillator
+    if(!myMusicOscillator.save(out)) return false;
 
     // Clock info for Thumbulator
     out.putLong(myARMCycles);
@@ -752,9 +741,8 @@ bool CartridgeDPCPlus::load(Serializer& in)
     // The random number generator register
     myRandomNumber = in.getInt();
 
-    // Get audio cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // The music oscillator
+    if(!myMusicOscillator.load(in)) return false;
 
     // Clock info for Thumbulator
     myARMCycles = in.getLong();
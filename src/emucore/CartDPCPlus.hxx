@@ -27,6 +27,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicOscillator.hxx"
 
 /**
   Cartridge class used for DPC+, derived from Pitfall II.  There are six 4K
@@ -263,14 +264,11 @@ class CartridgeDPCPlus : public Cartridge
     // The random number generator register
     uInt32 myRandomNumber{1};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // System cycle count when the last Thumbulator::run() occurred
     uInt64 myARMCycles{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // The music oscillator, clocking the music data fetchers
+    MusicOscillator myMusicOscillator;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
@@ -19,6 +19,7 @@
 #define CARTRIDGE_DETECTOR_HXX
 
 #include "Bankswitch.hxx"
+#include "SignatureIndex.hxx"
 #include "bspf.hxx"
 
 /**
@@ -40,6 +41,17 @@ class CartDetector
     */
     static Bankswitch::Type autodetectType(const ByteBuffer& image, size_t size);
 
+    /**
+      Try to auto-detect the bankswitching type of the cartridge, using an
+      existing index of the ROM image (e.g. shared with the controller
+      autodetection)
+
+      @param image  The index of the ROM image
+
+      @return The "best guess" for the cartridge type
+    */
+    static Bankswitch::Type autodetectType(const SignatureIndex& image);
+
   private:
     /**
       Search the image for the specified byte signature
@@ -56,163 +68,163 @@ class CartDetector
                                const uInt8* signature, uInt32 sigsize,
                                uInt32 minhits = 1);
 
-    static bool searchForBytes(const ByteBuffer& image, size_t imagesize,
+    static bool searchForBytes(const SignatureIndex& image, size_t imagesize,
                                const uInt8* signature, uInt32 sigsize,
                                uInt32 minhits = 1)
     {
-      return searchForBytes(image.get(), imagesize, signature, sigsize, minhits);
+      return image.search(signature, sigsize, minhits, imagesize);
     }
 
     /**
       Returns true if the image is probably a SuperChip (128 bytes RAM)
       Note: should be called only on ROMs with size multiple of 4K
     */
-    static bool isProbablySC(const ByteBuffer& image, size_t size);
+    static bool isProbablySC(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const ByteBuffer& image, size_t size);
+    static bool isProbablyARM(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const ByteBuffer& image, size_t size);
+    static bool isProbably0840(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const ByteBuffer& image, size_t size);
+    static bool isProbably3E(const SignatureIndex& image, size_t size);
 
     /**
     Returns true if the image is probably a 3EX bankswitching cartridge
     */
-    static bool isProbably3EX(const ByteBuffer& image, size_t size);
+    static bool isProbably3EX(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const ByteBuffer& image, size_t size);
+    static bool isProbably3EPlus(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const ByteBuffer& image, size_t size);
+    static bool isProbably3F(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
     */
-    static bool isProbably4A50(const ByteBuffer& image, size_t size);
+    static bool isProbably4A50(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a 4K SuperChip (128 bytes RAM)
     */
-    static bool isProbably4KSC(const ByteBuffer& image, size_t size);
+    static bool isProbably4KSC(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a BF/BFSC bankswitching cartridge
     */
-    static bool isProbablyBF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyBF(const SignatureIndex& image, size_t size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const ByteBuffer& image, size_t size);
+    static bool isProbablyBUS(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const ByteBuffer& image, size_t size);
+    static bool isProbablyCDF(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const ByteBuffer& image, size_t size);
+    static bool isProbablyCTY(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const ByteBuffer& image, size_t size);
+    static bool isProbablyCV(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
     */
-    static bool isProbablyDF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyDF(const SignatureIndex& image, size_t size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const ByteBuffer& image, size_t size);
+    static bool isProbablyDPCplus(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const ByteBuffer& image, size_t size);
+    static bool isProbablyE0(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const ByteBuffer& image, size_t size);
+    static bool isProbablyE7(const SignatureIndex& image, size_t size);
 
     /**
     Returns true if the image is probably a E78K bankswitching cartridge
     */
-    static bool isProbablyE78K(const ByteBuffer& image, size_t size);
+    static bool isProbablyE78K(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyEF(const SignatureIndex& image, size_t size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
     */
-    //static bool isProbablyF6(const ByteBuffer& image, size_t size);
+    //static bool isProbablyF6(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably an FA2 bankswitching cartridge
     */
-    static bool isProbablyFA2(const ByteBuffer& image, size_t size);
+    static bool isProbablyFA2(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably an FC bankswitching cartridge
     */
-    static bool isProbablyFC(const ByteBuffer& image, size_t size);
+    static bool isProbablyFC(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const ByteBuffer& image, size_t size);
+    static bool isProbablyFE(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const ByteBuffer& image, size_t size);
+    static bool isProbablyMDM(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const ByteBuffer& image, size_t size);
+    static bool isProbablySB(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a TV Boy bankswitching cartridge
     */
-    static bool isProbablyTVBoy(const ByteBuffer& image, size_t size);
+    static bool isProbablyTVBoy(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const ByteBuffer& image, size_t size);
+    static bool isProbablyUA(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably a Wickstead Design bankswitching cartridge
     */
-    static bool isProbablyWD(const ByteBuffer& image, size_t size);
+    static bool isProbablyWD(const SignatureIndex& image, size_t size);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const ByteBuffer& image, size_t size);
+    static bool isProbablyX07(const SignatureIndex& image, size_t size);
 
   private:
     // Following constructors and assignment operators not supported
@@ -61,6 +61,7 @@
 #include "FrameLayout.hxx"
 #include "AudioQueue.hxx"
 #include "AudioSettings.hxx"
+#include "XXH64.hxx"
 #include "frame-manager/FrameManager.hxx"
 #include "frame-manager/FrameLayoutDetector.hxx"
 
@@ -75,11 +76,13 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-                 const Properties& props, AudioSettings& audioSettings)
+                 const Properties& props, AudioSettings& audioSettings,
+                 const RomCache::Entry& cached)
   : myOSystem(osystem),
     myEvent(osystem.eventHandler().event()),
     myProperties(props),
     myCart(std::move(cart)),
+    myAutodetected(cached),
     myAudioSettings(audioSettings)
 {
   // Create subsystems for the console
@@ -130,7 +133,16 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   myOSystem.sound().mute(1);
   myOSystem.frameBuffer().clear();
 
-  if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
+  if(myDisplayFormat == "AUTO" && myAutodetected.displayFormat != EmptyString &&
+     !myOSystem.settings().getBool("rominfo"))
+  {
+    // Use the cached result of a previous autodetection
+    myDisplayFormat = myAutodetected.displayFormat;
+    autodetected = "*";
+    myCurrentFormat = 0;
+    myFormatAutodetected = true;
+  }
+  else if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
     autodetectFrameLayout();
 
@@ -140,6 +152,7 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
       myCurrentFormat = 0;
       myFormatAutodetected = true;
     }
+    myAutodetected.displayFormat = myDisplayFormat;
   }
 
   myConsoleInfo.DisplayFormat = myDisplayFormat + autodetected;
@@ -179,6 +192,18 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   bool joyallow4 = myOSystem.settings().getBool("joyallow4");
   myOSystem.eventHandler().allowAllDirections(joyallow4);
 
+  // Print the frame hashes every n frames, if requested
+  const uInt32 hashInterval = myOSystem.settings().getInt("framehash");
+  if(hashInterval > 0)
+  {
+    myTIA->enableHashing(true);
+    myTIA->setFrameHashCallback([this, hashInterval](uInt32 frame, uInt64 hash) {
+      if(frame % hashInterval == 0)
+        cout << "frame " << frame << ": " << XXH64::toString(hash)
+             << " audio: " << XXH64::toString(myTIA->audioHash()) << endl;
+    });
+  }
+
   // Reset the system to its power-on state
   mySystem->reset();
   myRiot->update();
@@ -697,6 +722,7 @@ void Console::createAudioQueue()
     myEmulationTiming.audioQueueCapacity(),
     useStereo
   );
+  myAudioQueue->telemetry().setEnabled(myAudioSettings.telemetry());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -732,11 +758,32 @@ void Console::setControllers(const string& romMd5)
     // Try to detect controllers
     if(image != nullptr && size != 0)
     {
+      const bool rominfo = myOSystem.settings().getBool("rominfo");
+      unique_ptr<SignatureIndex> index;
+
+      // Detection results are cached per jack, independent of swapped ports
+      auto detect = [&](Controller::Type type, Controller::Jack port) {
+        string& cached = port == Controller::Jack::Left
+          ? myAutodetected.leftController : myAutodetected.rightController;
+
+        if(type == Controller::Type::Unknown && cached != EmptyString && !rominfo)
+          return Controller::getType(cached);
+
+        if(!index)
+          index = make_unique<SignatureIndex>(image, size);
+        const Controller::Type detected =
+          ControllerDetector::detectType(*index, type, port, myOSystem.settings());
+        if(type == Controller::Type::Unknown)
+          cached = Controller::getPropName(detected);
+
+        return detected;
+      };
+
       Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-      leftType = ControllerDetector::detectType(image, size, leftType,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right, myOSystem.settings());
-      rightType = ControllerDetector::detectType(image, size, rightType,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left, myOSystem.settings());
+      leftType = detect(leftType,
+          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right);
+      rightType = detect(rightType,
+          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left);
     }
 
     unique_ptr<Controller> leftC = getControllerPort(leftType, Controller::Jack::Left, romMd5),
@@ -847,7 +894,8 @@ unique_ptr<Controller> Console::getControllerPort(const Controller::Type type,
       break;
 
     case Controller::Type::KidVid:
-      controller = make_unique<KidVid>(port, myEvent, *mySystem, romMd5);
+      controller = make_unique<KidVid>(port, myEvent, *mySystem, romMd5,
+                                      myOSystem.baseDir());
       break;
 
     case Controller::Type::MindLink:
@@ -34,6 +34,7 @@ class AudioSettings;
 #include "ConsoleIO.hxx"
 #include "Control.hxx"
 #include "Props.hxx"
+#include "RomCache.hxx"
 #include "TIAConstants.hxx"
 #include "FrameBuffer.hxx"
 #include "FrameBufferConstants.hxx"
@@ -71,9 +72,12 @@ class Console : public Serializable, public ConsoleIO
       @param osystem  The OSystem object to use
       @param cart     The cartridge to use with this console
       @param props    The properties for the cartridge
+      @param cached   Cached autodetection results for the cartridge;
+                      empty values are autodetected
     */
     Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-            const Properties& props, AudioSettings& audioSettings);
+            const Properties& props, AudioSettings& audioSettings,
+            const RomCache::Entry& cached = RomCache::Entry());
 
     /**
       Destructor
@@ -165,6 +169,11 @@ class Console : public Serializable, public ConsoleIO
     */
     const ConsoleInfo& about() const { return myConsoleInfo; }
 
+    /**
+      The autodetection results for the cartridge (cached or detected).
+    */
+    const RomCache::Entry& autodetected() const { return myAutodetected; }
+
     /**
       Timing information for this console.
     */
@@ -185,6 +194,11 @@ class Console : public Serializable, public ConsoleIO
      */
     EmulationTiming& emulationTiming() { return myEmulationTiming; }
 
+    /**
+      Retrieve the audio queue (null until audio has been initialized).
+     */
+    AudioQueue* audioQueue() const { return myAudioQueue.get(); }
+
   public:
     /**
       Toggle between NTSC/PAL/SECAM (and variants) display format.
@@ -407,6 +421,9 @@ class Console : public Serializable, public ConsoleIO
     // Contains detailed info about this console
     ConsoleInfo myConsoleInfo;
 
+    // The autodetected controllers and display format
+    RomCache::Entry myAutodetected;
+
     // Contains timing information for this console
     ConsoleTiming myConsoleTiming{ConsoleTiming::ntsc};
 
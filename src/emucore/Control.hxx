@@ -191,6 +191,21 @@ class Controller : public Serializable
     */
     virtual bool isAnalog() const { return false; }
 
+    /**
+      Answers whether the controller contains an audio source (e.g. the
+      KidVid tape) that is mixed into the TIA output.
+    */
+    virtual bool hasAudio() const { return false; }
+
+    /**
+      Generate the next samples of the controller's audio source.  This is
+      called from the emulation once per audio fragment.
+
+      @param samples  The buffer to fill (signed mono samples, TIA sample rate)
+      @param count    The number of samples to generate
+    */
+    virtual void generateAudio(Int16* samples, uInt32 count) { }
+
     /**
       Notification method invoked by the system after its reset method has
       been called.  It may be necessary to override this method for
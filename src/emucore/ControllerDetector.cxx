@@ -26,8 +26,25 @@ Controller::Type ControllerDetector::detectType(const uInt8* image, size_t size,
     const Controller::Type type, const Controller::Jack port, const Settings& settings)
 {
   if(type == Controller::Type::Unknown || settings.getBool("rominfo"))
+    return detectType(SignatureIndex(image, size), type, port, settings);
+
+  return type;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Controller::Type ControllerDetector::detectType(const SignatureIndex& image,
+    const Controller::Type type, const Controller::Jack port, const Settings& settings)
+{
+  return detectType(image, type, port, settings.getBool("rominfo"));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Controller::Type ControllerDetector::detectType(const SignatureIndex& image,
+    const Controller::Type type, const Controller::Jack port, bool romInfo)
+{
+  if(type == Controller::Type::Unknown || romInfo)
   {
-    Controller::Type detectedType = autodetectPort(image, size, port, settings);
+    Controller::Type detectedType = autodetectPort(image, image.size(), port);
 
     if(type != Controller::Type::Unknown && type != detectedType)
     {
@@ -51,8 +68,16 @@ string ControllerDetector::detectName(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Controller::Type ControllerDetector::autodetectPort(const uInt8* image, size_t size,
-    Controller::Jack port, const Settings& settings)
+string ControllerDetector::detectName(const SignatureIndex& image,
+    const Controller::Type controller, const Controller::Jack port,
+    const Settings& settings)
+{
+  return Controller::getName(detectType(image, controller, port, settings));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Controller::Type ControllerDetector::autodetectPort(const SignatureIndex& image, size_t size,
+    Controller::Jack port)
 {
   // default type joystick
   Controller::Type type = Controller::Type::Joystick;
@@ -74,12 +99,12 @@ Controller::Type ControllerDetector::autodetectPort(const uInt8* image, size_t s
     else if(isProbablyLightGun(image, size, port))
       type = Controller::Type::Lightgun;
     // add check for games which support joystick and paddles, prefer paddles here
-    else if(usesPaddle(image, size, port, settings))
+    else if(usesPaddle(image, size, port))
       type = Controller::Type::Paddles;
   }
   else
   {
-    if(usesPaddle(image, size, port, settings))
+    if(usesPaddle(image, size, port))
       type = Controller::Type::Paddles;
   }
   // TODO: BOOSTERGRIP, DRIVING, MINDLINK, ATARIVOX, KIDVID
@@ -88,31 +113,7 @@ Controller::Type ControllerDetector::autodetectPort(const uInt8* image, size_t s
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::searchForBytes(const uInt8* image, size_t imagesize,
-                                        const uInt8* signature, uInt32 sigsize)
-{
-  if (imagesize >= sigsize)
-    for(uInt32 i = 0; i < imagesize - sigsize; ++i)
-    {
-      uInt32 matches = 0;
-      for(uInt32 j = 0; j < sigsize; ++j)
-      {
-        if(image[i + j] == signature[j])
-          ++matches;
-        else
-          break;
-      }
-      if(matches == sigsize)
-      {
-        return true;
-      }
-    }
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesJoystickButton(const uInt8* image, size_t size,
+bool ControllerDetector::usesJoystickButton(const SignatureIndex& image, size_t size,
                                             Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -242,7 +243,7 @@ bool ControllerDetector::usesJoystickButton(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesKeyboard(const uInt8* image, size_t size,
+bool ControllerDetector::usesKeyboard(const SignatureIndex& image, size_t size,
                                       Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -383,7 +384,7 @@ bool ControllerDetector::usesKeyboard(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesGenesisButton(const uInt8* image, size_t size,
+bool ControllerDetector::usesGenesisButton(const SignatureIndex& image, size_t size,
                                            Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -440,8 +441,8 @@ bool ControllerDetector::usesGenesisButton(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesPaddle(const uInt8* image, size_t size,
-                                    Controller::Jack port, const Settings& settings)
+bool ControllerDetector::usesPaddle(const SignatureIndex& image, size_t size,
+                                    Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
   {
@@ -549,7 +550,7 @@ bool ControllerDetector::usesPaddle(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyTrakBall(const uInt8* image, size_t size)
+bool ControllerDetector::isProbablyTrakBall(const SignatureIndex& image, size_t size)
 {
   // check for TrakBall tables
   const int NUM_SIGS = 3;
@@ -568,7 +569,7 @@ bool ControllerDetector::isProbablyTrakBall(const uInt8* image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyAtariMouse(const uInt8* image, size_t size)
+bool ControllerDetector::isProbablyAtariMouse(const SignatureIndex& image, size_t size)
 {
   // check for Atari Mouse tables
   const int NUM_SIGS = 3;
@@ -587,7 +588,7 @@ bool ControllerDetector::isProbablyAtariMouse(const uInt8* image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyAmigaMouse(const uInt8* image, size_t size)
+bool ControllerDetector::isProbablyAmigaMouse(const SignatureIndex& image, size_t size)
 {
   // check for Amiga Mouse tables
   const int NUM_SIGS = 4;
@@ -607,7 +608,7 @@ bool ControllerDetector::isProbablyAmigaMouse(const uInt8* image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablySaveKey(const uInt8* image, size_t size,
+bool ControllerDetector::isProbablySaveKey(const SignatureIndex& image, size_t size,
                                            Controller::Jack port)
 {
   // check for known SaveKey code, only supports right port
@@ -652,7 +653,7 @@ bool ControllerDetector::isProbablySaveKey(const uInt8* image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyLightGun(const uInt8* image, size_t size,
+bool ControllerDetector::isProbablyLightGun(const SignatureIndex& image, size_t size,
                                             Controller::Jack port)
 {
   if (port == Controller::Jack::Left)
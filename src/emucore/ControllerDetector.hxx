@@ -21,6 +21,7 @@
 class Settings;
 
 #include "Control.hxx"
+#include "SignatureIndex.hxx"
 
 /**
   Auto-detect controller type by matching determining pattern.
@@ -61,60 +62,81 @@ class ControllerDetector
         const Controller::Type type, const Controller::Jack port,
         const Settings& settings);
 
+    /**
+      Detect the controller type (or its name) using an existing index of the
+      ROM image, e.g. to share it between both ports.
+    */
+    static Controller::Type detectType(const SignatureIndex& image,
+        const Controller::Type controller, const Controller::Jack port,
+        const Settings& settings);
+    static string detectName(const SignatureIndex& image,
+        const Controller::Type type, const Controller::Jack port,
+        const Settings& settings);
+
+    /**
+      Same as above, with the value of the 'rominfo' setting passed directly,
+      so that it can be used without access to the settings (e.g. in other
+      threads).
+    */
+    static Controller::Type detectType(const SignatureIndex& image,
+        const Controller::Type controller, const Controller::Jack port,
+        bool romInfo);
+
   private:
     /**
       Detects the controller type at the given port.
 
-      @param image      A pointer to the ROM image
+      @param image      The index of the ROM image
       @param size       The size of the ROM image
       @param port       The port to be checked
-      @param settings   A reference to the various settings (read-only)
 
       @return   The detected controller type
     */
-    static Controller::Type autodetectPort(const uInt8* image, size_t size,
-        Controller::Jack port, const Settings& settings);
+    static Controller::Type autodetectPort(const SignatureIndex& image, size_t size,
+        Controller::Jack port);
 
     /**
       Search the image for the specified byte signature.
 
-      @param image      A pointer to the ROM image
+      @param image      The index of the ROM image
       @param imagesize  The size of the ROM image
       @param signature  The byte sequence to search for
       @param sigsize    The number of bytes in the signature
 
       @return  True if the signature was found, else false
     */
-    static bool searchForBytes(const uInt8* image, size_t imagesize,
-                               const uInt8* signature, uInt32 sigsize);
+    static bool searchForBytes(const SignatureIndex& image, size_t imagesize,
+                               const uInt8* signature, uInt32 sigsize)
+    {
+      return image.search(signature, sigsize, 1, imagesize);
+    }
 
     // Returns true if the port's joystick button access code is found.
-    static bool usesJoystickButton(const uInt8* image, size_t size, Controller::Jack port);
+    static bool usesJoystickButton(const SignatureIndex& image, size_t size, Controller::Jack port);
 
     // Returns true if the port's keyboard access code is found.
-    static bool usesKeyboard(const uInt8* image, size_t size, Controller::Jack port);
+    static bool usesKeyboard(const SignatureIndex& image, size_t size, Controller::Jack port);
 
     // Returns true if the port's 2nd Genesis button access code is found.
-    static bool usesGenesisButton(const uInt8* image, size_t size, Controller::Jack port);
+    static bool usesGenesisButton(const SignatureIndex& image, size_t size, Controller::Jack port);
 
     // Returns true if the port's paddle button access code is found.
-    static bool usesPaddle(const uInt8* image, size_t size, Controller::Jack port,
-                           const Settings& settings);
+    static bool usesPaddle(const SignatureIndex& image, size_t size, Controller::Jack port);
 
     // Returns true if a Trak-Ball table is found.
-    static bool isProbablyTrakBall(const uInt8* image, size_t size);
+    static bool isProbablyTrakBall(const SignatureIndex& image, size_t size);
 
     // Returns true if an Atari Mouse table is found.
-    static bool isProbablyAtariMouse(const uInt8* image, size_t size);
+    static bool isProbablyAtariMouse(const SignatureIndex& image, size_t size);
 
     // Returns true if an Amiga Mouse table is found.
-    static bool isProbablyAmigaMouse(const uInt8* image, size_t size);
+    static bool isProbablyAmigaMouse(const SignatureIndex& image, size_t size);
 
     // Returns true if a SaveKey code pattern is found.
-    static bool isProbablySaveKey(const uInt8* image, size_t size, Controller::Jack port);
+    static bool isProbablySaveKey(const SignatureIndex& image, size_t size, Controller::Jack port);
 
     // Returns true if a Lightgun code pattern is found
-    static bool isProbablyLightGun(const uInt8* image, size_t size, Controller::Jack port);
+    static bool isProbablyLightGun(const SignatureIndex& image, size_t size, Controller::Jack port);
 
 
   private:
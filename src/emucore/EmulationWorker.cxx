@@ -20,11 +20,13 @@
 #include "EmulationWorker.hxx"
 #include "DispatchResult.hxx"
 #include "TIA.hxx"
+#include "FrameTiming.hxx"
 
 using namespace std::chrono;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-EmulationWorker::EmulationWorker()
+EmulationWorker::EmulationWorker(FrameTiming& frameTiming)
+  : myFrameTiming(frameTiming)
 {
   std::mutex mutex;
   std::unique_lock<std::mutex> lock(mutex);
@@ -69,7 +71,8 @@ void EmulationWorker::handlePossibleException()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia)
+void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+                            bool continueTimeline)
 {
   // Wait until any pending signal has been processed
   waitUntilPendingSignalHasProcessed();
@@ -97,6 +100,7 @@ void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 min
     myMaxCycles = maxCycles;
     myMinCycles = minCycles;
     myDispatchResult = dispatchResult;
+    myContinueTimeline = continueTimeline;
 
     // Raise the signal...
     myPendingSignal = Signal::resume;
@@ -203,10 +207,27 @@ void EmulationWorker::handleWakeupFromWaitingForResume(std::unique_lock<std::mut
       // Clear the pending signal and notify the main thread
       clearSignal();
 
-      // Reset virtual clock and cycle counter
-      myVirtualTime = high_resolution_clock::now();
       myTotalCycles = 0;
 
+      if (myContinueTimeline) {
+        const time_point<high_resolution_clock> now = high_resolution_clock::now();
+        const duration<double> maxLag(static_cast<double>(myMaxCycles) / static_cast<double>(myCyclesPerSecond));
+
+        // Start over if we have fallen behind too far
+        if (now - myVirtualTime > duration_cast<high_resolution_clock::duration>(maxLag))
+          myVirtualTime = now;
+
+        // If we are ahead of real time, sleep until the timeslice is due
+        if (myVirtualTime > now) {
+          myState = State::waitingForStop;
+          myWakeupCondition.wait_until(lock, myVirtualTime);
+          break;
+        }
+      }
+      else
+        // Reset virtual clock
+        myVirtualTime = high_resolution_clock::now();
+
       // Enter emulation. This will emulate a timeslice and set the state upon completion.
       dispatchEmulation(lock);
       break;
@@ -263,12 +284,15 @@ void EmulationWorker::dispatchEmulation(std::unique_lock<std::mutex>& lock)
   myState = State::running;
 
   uInt64 totalCycles = 0;
+  const FrameTiming::TimePoint start = FrameTiming::now();
 
   do {
     myTia->update(*myDispatchResult, totalCycles > 0 ? myMinCycles - totalCycles : myMaxCycles);
     totalCycles += myDispatchResult->getCycles();
   } while (totalCycles < myMinCycles && myDispatchResult->getStatus() == DispatchResult::Status::ok);
 
+  myFrameTiming.record(FrameTiming::Metric::emulation, start, FrameTiming::now());
+
   myTotalCycles += totalCycles;
 
   bool continueEmulating = false;
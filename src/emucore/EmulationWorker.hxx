@@ -33,6 +33,11 @@
  * In combination, the scheduling in the main loop and the microscheduling in the worker
  * ensure that the emulation continues to run even if rendering blocks, ensuring the real
  * time scheduling required for cycle exact audio to work.
+ *
+ * In decoupled mode, the worker continues its 6507 time across runs instead of starting over
+ * when it is resumed. The main loop only stops it to handle events and presents the latest frame
+ * published by the TIA. Thus, the emulation is paced by the worker alone, and a slow
+ * presentation cannot shift the emulation schedule.
  */
 
 #ifndef EMULATION_WORKER_HXX
@@ -49,6 +54,7 @@
 
 class TIA;
 class DispatchResult;
+class FrameTiming;
 
 class EmulationWorker
 {
@@ -56,8 +62,9 @@ class EmulationWorker
 
     /**
       The constructor starts the worker thread and waits until it has initialized.
+      The time spent emulating is reported to frameTiming.
      */
-    EmulationWorker();
+    explicit EmulationWorker(FrameTiming& frameTiming);
 
     /**
       The destructor signals quit to the worker and joins.
@@ -66,8 +73,14 @@ class EmulationWorker
 
     /**
       Wake up the worker and start emulation with the specified parameters.
+
+      If continueTimeline is set, the worker continues the 6507 time of the
+      previous run instead of starting over at the current time. This way, the
+      emulation is paced by the worker alone, no matter how long it has been
+      stopped (as long as it does not fall behind by more than a timeslice).
      */
-    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia);
+    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+               bool continueTimeline = false);
 
     /**
       Stop emulation and return the number of 6507 cycles emulated.
@@ -193,6 +206,10 @@ class EmulationWorker
     uInt64 myMaxCycles{0};
     uInt64 myMinCycles{0};
     DispatchResult* myDispatchResult{nullptr};
+    bool myContinueTimeline{false};
+
+    // Frame pacing statistics
+    FrameTiming& myFrameTiming;
 
     // Total number of cycles during this emulation run
     uInt64 myTotalCycles{0};
@@ -201,6 +218,7 @@ class EmulationWorker
 
   private:
 
+    EmulationWorker() = delete;
     EmulationWorker(const EmulationWorker&) = delete;
 
     EmulationWorker(EmulationWorker&&) = delete;
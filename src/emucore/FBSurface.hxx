@@ -305,6 +305,25 @@ class FBSurface
     */
     virtual void invalidate() = 0;
 
+    /**
+      By default, the complete surface is transferred to the screen each time
+      it is rendered.  Surfaces whose contents are updated regularly can
+      enable dirty tracking instead, and must then call markDirtyRows() for
+      all rows they modify; only those rows are transferred on the next
+      render.  These are only hints, so child classes may ignore them.
+
+      @param enable  Whether to enable dirty tracking
+    */
+    virtual void setDirtyTracking(bool enable) { }
+
+    /**
+      Mark rows of the surface as modified (see setDirtyTracking()).
+
+      @param y  The first modified row
+      @param h  The number of modified rows
+    */
+    virtual void markDirtyRows(uInt32 y, uInt32 h) { }
+
     /**
       This method should be called to free any resources being used by
       the surface.
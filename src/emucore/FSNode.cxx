@@ -18,6 +18,8 @@
 //   Copyright (C) 2002-2004 The ScummVM project
 //============================================================================
 
+#include <map>
+
 #include "FSNodeFactory.hxx"
 #include "FSNode.hxx"
 
@@ -48,38 +50,74 @@ bool FilesystemNode::exists() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNode::getChildren(FSList& fslist, ListMode mode,
                                  const NameFilter& filter,
-                                 bool includeParentDirectory) const
+                                 bool includeParentDirectory,
+                                 const ListCallback& callback) const
 {
   if (!_realNode || !_realNode->isDirectory())
     return false;
 
+  // Number of nodes added between two callbacks
+  static constexpr size_t CALLBACK_BATCH = 256;
+  size_t reported = fslist.size();
+  const auto report = [&]() {
+    if (!callback)
+      return true;
+    const bool proceed = callback(fslist, reported);
+    reported = fslist.size();
+    return proceed;
+  };
+
   AbstractFSList tmp;
   tmp.reserve(fslist.capacity());
 
   if (!_realNode->getChildren(tmp, mode))
     return false;
+  if (!report())
+    return false;
 
   #if defined(ZIP_SUPPORT)
     // before sorting, replace single file ZIP archive names with contained file names
     //  because they are displayed using their contained file names
+    // The ZIP nodes are kept, so that each archive is only opened once
+    std::map<const AbstractFSNode*, AbstractFSNodePtr> zipNodes;
     for (auto& i : tmp)
     {
       if (BSPF::endsWithIgnoreCase(i->getPath(), ".zip"))
       {
-        FilesystemNodeZIP node(i->getPath());
+        AbstractFSNodePtr node = FilesystemNodeFactory::create(i->getPath(),
+            FilesystemNodeFactory::Type::ZIP);
 
-        i->setName(node.getName());
+        i->setName(node->getName());
+        zipNodes.emplace(i.get(), node);
       }
     }
+    if (!report())
+      return false;
   #endif
 
-  std::sort(tmp.begin(), tmp.end(),
-    [](const AbstractFSNodePtr& node1, const AbstractFSNodePtr& node2)
+  // Sort directories first, then by name (ignoring case); the case-folded
+  // names are only computed once per node
+  struct SortEntry
+  {
+    bool isFile;
+    string key;
+    AbstractFSNodePtr node;
+  };
+  vector<SortEntry> sorted;
+  sorted.reserve(tmp.size());
+  for (auto& i : tmp)
+  {
+    string key = i->getName();
+    BSPF::toLowerCase(key);
+    sorted.push_back({ !i->isDirectory(), std::move(key), i });
+  }
+  std::sort(sorted.begin(), sorted.end(),
+    [](const SortEntry& entry1, const SortEntry& entry2)
     {
-      if (node1->isDirectory() != node2->isDirectory())
-        return node1->isDirectory();
+      if (entry1.isFile != entry2.isFile)
+        return entry2.isFile;
       else
-        return BSPF::compareIgnoreCase(node1->getName(), node2->getName()) < 0;
+        return entry1.key < entry2.key;
     }
   );
 
@@ -92,15 +130,13 @@ bool FilesystemNode::getChildren(FSList& fslist, ListMode mode,
   }
 
   // And now add the rest of the entries
-  for (const auto& i: tmp)
+  for (const auto& entry: sorted)
   {
+    const AbstractFSNodePtr& i = entry.node;
   #if defined(ZIP_SUPPORT)
     if (BSPF::endsWithIgnoreCase(i->getPath(), ".zip"))
     {
-      // Force ZIP c'tor to be called
-      AbstractFSNodePtr ptr = FilesystemNodeFactory::create(i->getPath(),
-          FilesystemNodeFactory::Type::ZIP);
-      FilesystemNode node(ptr);
+      FilesystemNode node(zipNodes[i.get()]);
       if (filter(node))
         fslist.emplace_back(node);
     }
@@ -115,9 +151,12 @@ bool FilesystemNode::getChildren(FSList& fslist, ListMode mode,
       if (filter(node))
         fslist.emplace_back(node);
     }
+
+    if (fslist.size() - reported >= CALLBACK_BATCH && !report())
+      return false;
   }
 
-  return true;
+  return report();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -211,6 +250,18 @@ bool FilesystemNode::isWritable() const
   return _realNode ? _realNode->isWritable() : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t FilesystemNode::getSize() const
+{
+  return _realNode ? _realNode->getSize() : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FilesystemNode::getLastModified() const
+{
+  return _realNode ? _realNode->getLastModified() : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNode::makeDir()
 {
@@ -76,6 +76,12 @@ class FilesystemNode
         should be included, else false.*/
     using NameFilter = std::function<bool(const FilesystemNode& node)>;
 
+    /** Function called by getChildren() while the nodes are added, with the
+        list and the index of the first node added since the last call (it
+        may also be called without new nodes).  Returns false to cancel the
+        listing.*/
+    using ListCallback = std::function<bool(const FSList& list, size_t first)>;
+
     /**
      * Create a new pathless FilesystemNode. Since there's no path associated
      * with this node, path-related operations (i.e. exists(), isDirectory(),
@@ -130,12 +136,17 @@ class FilesystemNode
      * Return a list of child nodes of this directory node. If called on a node
      * that does not represent a directory, false is returned.
      *
+     * The nodes are added in sorted order; the optional callback allows to
+     * show them while the listing is still in progress (e.g. when listing
+     * on another thread), and to cancel it.
+     *
      * @return true if successful, false otherwise (e.g. when the directory
-     *         does not exist).
+     *         does not exist, or the listing was cancelled).
      */
     bool getChildren(FSList& fslist, ListMode mode = ListMode::DirectoriesOnly,
                      const NameFilter& filter = [](const FilesystemNode&){ return true; },
-                     bool includeParentDirectory = true) const;
+                     bool includeParentDirectory = true,
+                     const ListCallback& callback = nullptr) const;
 
     /**
      * Set/get a string representation of the name of the file. This is can be
@@ -216,6 +227,15 @@ class FilesystemNode
      */
     bool isWritable() const;
 
+    /**
+     * The size of the file and the time of its last modification
+     * (nanoseconds since the epoch, at the resolution of the filesystem).
+     * Both are 0 if unknown (e.g. for directories, or if not supported by
+     * the filesystem).
+     */
+    size_t getSize() const;
+    uInt64 getLastModified() const;
+
     /**
      * Create a directory from the current node path.
      *
@@ -375,6 +395,13 @@ class AbstractFSNode
      */
     virtual bool isWritable() const = 0;
 
+    /**
+     * The size of the file and the time of its last modification
+     * (nanoseconds since the epoch), or 0 if unknown.
+     */
+    virtual size_t getSize() const { return 0; }
+    virtual uInt64 getLastModified() const { return 0; }
+
     /**
      * Create a directory from the current node path.
      *
@@ -25,6 +25,8 @@
 #include "Settings.hxx"
 #include "TIA.hxx"
 #include "Sound.hxx"
+#include "AudioQueue.hxx"
+#include "FrameTiming.hxx"
 
 #include "FBSurface.hxx"
 #include "TIASurface.hxx"
@@ -110,6 +112,18 @@ bool FrameBuffer::initialize()
 
   myGrabMouse = myOSystem.settings().getBool("grabmouse");
 
+  Settings& settings = myOSystem.settings();
+  myTurboHandle = settings.handle("turbo");
+  mySpeedHandle = settings.handle("speed");
+  myDevSettingsHandle = settings.handle("dev.settings");
+
+  // The settings are destroyed before the framebuffer, so the observer
+  // never has to be removed
+  const Settings::Handle messages = settings.handle("uimessages");
+  myShowMessages = settings.getBool(messages);
+  settings.addObserver(messages,
+      [this](const Variant& value) { myShowMessages = value.toBool(); });
+
   // Create a TIA surface; we need it for rendering TIA images
   myTIASurface = make_unique<TIASurface>(myOSystem);
 
@@ -298,7 +312,9 @@ FBInitStatus FrameBuffer::createDisplay(const string& title, BufferType type,
   const GUI::Font& f = hidpiEnabled() ? infoFont() : font();
   myStatsMsg.color = kColorInfo;
   myStatsMsg.w = f.getMaxCharWidth() * 40 + 3;
-  myStatsMsg.h = (f.getFontHeight() + 2) * 3;
+  // Space for three lines of frame stats, two lines of audio telemetry and
+  // three lines of frame timing
+  myStatsMsg.h = (f.getFontHeight() + 2) * 8;
 
   if(!myStatsMsg.surface)
   {
@@ -473,8 +489,19 @@ void FrameBuffer::updateInEmulationMode(float framesPerSecond)
   // We don't worry about selective rendering here; the rendering
   // always happens at the full framerate
 
+  renderEmulationFrame(framesPerSecond);
+  presentEmulationFrame();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::renderEmulationFrame(float framesPerSecond)
+{
+  FrameTiming& timing = myOSystem.frameTiming();
+
   clear();  // TODO - test this: it may cause slowdowns on older systems
+  const FrameTiming::TimePoint conversionStart = FrameTiming::now();
   myTIASurface->render();
+  timing.record(FrameTiming::Metric::conversion, conversionStart, FrameTiming::now());
 
   // Show frame statistics
   if(myStatsMsg.enabled)
@@ -486,9 +513,17 @@ void FrameBuffer::updateInEmulationMode(float framesPerSecond)
   // Draw any pending messages
   if(myMsg.enabled)
     drawMessage();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::presentEmulationFrame()
+{
+  FrameTiming& timing = myOSystem.frameTiming();
 
   // Push buffers to screen
+  const FrameTiming::TimePoint presentStart = FrameTiming::now();
   renderToScreen();
+  timing.framePresented(presentStart, FrameTiming::now());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -497,7 +532,7 @@ void FrameBuffer::showMessage(const string& message, MessagePosition position,
 {
 #ifdef GUI_SUPPORT
   // Only show messages if they've been enabled
-  if(myMsg.surface == nullptr || !(force || myOSystem.settings().getBool("uimessages")))
+  if(myMsg.surface == nullptr || !(force || myShowMessages))
     return;
 
   const int fontWidth  = font().getMaxCharWidth(),
@@ -530,7 +565,7 @@ void FrameBuffer::showMessage(const string& message, const string& valueText,
 {
 #ifdef GUI_SUPPORT
   // Only show messages if they've been enabled
-  if(myMsg.surface == nullptr || !myOSystem.settings().getBool("uimessages"))
+  if(myMsg.surface == nullptr || !myShowMessages)
     return;
 
   const int fontWidth  = font().getMaxCharWidth(),
@@ -609,9 +644,9 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
     << std::fixed << std::setprecision(1) << framesPerSecond
     << "fps @ "
     << std::fixed << std::setprecision(0) << 100 *
-      (myOSystem.settings().getBool("turbo")
+      (myOSystem.settings().getBool(myTurboHandle)
         ? 20.0F
-        : myOSystem.settings().getFloat("speed"))
+        : myOSystem.settings().getFloat(mySpeedHandle))
     << "% speed";
 
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
@@ -621,14 +656,95 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
   ss.str("");
 
   ss << info.BankSwitch;
-  if (myOSystem.settings().getBool("dev.settings")) ss << "| Developer";
+  if (myOSystem.settings().getBool(myDevSettingsHandle)) ss << "| Developer";
 
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
       myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
 
+  // draw audio pipeline statistics
+  AudioQueue* audioQueue = myOSystem.console().audioQueue();
+  if(audioQueue && audioQueue->telemetry().enabled())
+  {
+    AudioTelemetry& telemetry = audioQueue->telemetry();
+    const AudioTelemetry::Record record = telemetry.lastRecord();
+
+    yPos += dy;
+    ss.str("");
+
+    ss
+      << "Audio: " << record.queueDepth << "/" << audioQueue->capacity()
+      << " frags, " << telemetry.underruns() << " under, "
+      << telemetry.overflows() << " over";
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+
+    yPos += dy;
+    ss.str("");
+
+    ss
+      << std::fixed << std::setprecision(0) << record.latency
+      << "ms (p95 " << telemetry.latency().percentile(95) << "ms), ratio "
+      << std::setprecision(4) << telemetry.effectiveRatio();
+    if(record.rateAdjustment != 0)
+      ss << " " << std::showpos << std::setprecision(0) << record.rateAdjustment
+         << std::noshowpos << "ppm";
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+  }
+
+  // draw frame pacing statistics
+  const FrameTiming& timing = myOSystem.frameTiming();
+  if(timing.enabled())
+  {
+    const auto percentiles = [&](FrameTiming::Metric metric) {
+      const Histogram& h = timing.histogram(metric);
+      ostringstream buf;
+
+      buf << std::fixed << std::setprecision(1) << h.percentile(50) << "/"
+          << h.percentile(95) << "/" << h.percentile(99) << "ms";
+      return buf.str();
+    };
+    const auto p95 = [&](FrameTiming::Metric metric) {
+      return timing.histogram(metric).percentile(95);
+    };
+
+    yPos += dy;
+    ss.str("");
+
+    ss << "Frame p50/95/99 " << percentiles(FrameTiming::Metric::interval);
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+
+    yPos += dy;
+    ss.str("");
+
+    ss << "Input p50/95/99 " << percentiles(FrameTiming::Metric::latency);
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+
+    yPos += dy;
+    ss.str("");
+
+    ss
+      << std::fixed << std::setprecision(1)
+      << "p95 emu " << p95(FrameTiming::Metric::emulation)
+      << " conv " << p95(FrameTiming::Metric::conversion)
+      << " pres " << p95(FrameTiming::Metric::present) << "ms";
+
+    myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+  }
+
+  const uInt32 h = yPos + dy;
+
+  myStatsMsg.surface->setSrcSize(myStatsMsg.w, h);
   myStatsMsg.surface->setDstPos(myImageRect.x() + 10, myImageRect.y() + 8);
   myStatsMsg.surface->setDstSize(myStatsMsg.w * hidpiScaleFactor(),
-                                 myStatsMsg.h * hidpiScaleFactor());
+                                 h * hidpiScaleFactor());
   myStatsMsg.surface->render();
 #endif
 }
@@ -31,6 +31,7 @@ class TIASurface;
 #endif
 
 #include "Rect.hxx"
+#include "Settings.hxx"
 #include "Variant.hxx"
 #include "TIAConstants.hxx"
 #include "FrameBufferConstants.hxx"
@@ -144,6 +145,14 @@ class FrameBuffer
      */
     void updateInEmulationMode(float framesPerSecond);
 
+    /**
+      The two parts of updateInEmulationMode.  Rendering the frame reads the
+      emulation state (TIA, statistics), while presenting it only pushes the
+      buffers to the screen, and so can overlap with the emulation.
+     */
+    void renderEmulationFrame(float framesPerSecond);
+    void presentEmulationFrame();
+
     /**
       Shows a message onscreen.
 
@@ -695,6 +704,12 @@ class FrameBuffer
     bool myStatsEnabled{false};
     uInt32 myLastScanlines{0};
 
+    // Settings shown in the frame stats, which are drawn every frame
+    Settings::Handle myTurboHandle, mySpeedHandle, myDevSettingsHandle;
+
+    // The value of "uimessages", updated whenever the setting changes
+    bool myShowMessages{true};
+
     bool myGrabMouse{false};
     bool myHiDPIAllowed{false};
     bool myHiDPIEnabled{false};
@@ -22,9 +22,10 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 KidVid::KidVid(Jack jack, const Event& event, const System& system,
-               const string& romMd5)
+               const string& romMd5, const string& sampleDir)
   : Controller(jack, event, system, Controller::Type::KidVid),
-    myEnabled(myJack == Jack::Right)
+    myEnabled(myJack == Jack::Right),
+    mySampleDir(sampleDir)
 {
   // Right now, there are only two games that use the KidVid
   if(romMd5 == "ee6665683ebdb539e89ba620981cb0f6")
@@ -148,11 +149,10 @@ void KidVid::update()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void KidVid::openSampleFile()
 {
-#if 0
-  static const char* const kvNameTable[6] = {
+  static constexpr std::array<const char*, 6> kvNameTable = {
     "kvs3.wav", "kvs1.wav", "kvs2.wav", "kvb3.wav", "kvb1.wav", "kvb2.wav"
   };
-  static uInt32 StartSong[6] = {
+  static constexpr std::array<uInt32, 6> StartSong = {
     44+38, 0, 44, 44+38+42+62+80, 44+38+42, 44+38+42+62
   };
 
@@ -165,44 +165,32 @@ void KidVid::openSampleFile()
     i += myTape - 1;
     if(myTape == 4) i -= 3;
 
-    mySampleFile = fopen(kvNameTable[i], "rb");
-    if(mySampleFile != nullptr)
+    mySampleFile.open(mySampleDir + kvNameTable[i], std::ios::binary);
+    if(mySampleFile.is_open())
     {
-cerr << "opened file: " << kvNameTable[i] << endl;
-      mySharedSampleFile = fopen("kvshared.wav", "rb");
-      if(mySharedSampleFile == nullptr)
-      {
-        fclose(mySampleFile);
-        myFileOpened = false;
-      }
-      else
-      {
-cerr << "opened file: " << "kvshared.wav" << endl;
-//         fseek(mySampleFile, 45, SEEK_SET);
+      mySharedSampleFile.open(mySampleDir + "kvshared.wav", std::ios::binary);
+      if(mySharedSampleFile.is_open())
         myFileOpened = true;
-      }
+      else
+        mySampleFile.close();
     }
-    else
-      myFileOpened = false;
 
     mySongCounter = 0;
     myTapeBusy = false;
     myFilePointer = StartSong[i];
+    mySampleBlockPos = mySampleBlockSize = 0;
   }
-#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void KidVid::closeSampleFile()
 {
-#if 0
   if(myFileOpened)
   {
-    fclose(mySampleFile);
-    fclose(mySharedSampleFile);
+    mySampleFile.close();
+    mySharedSampleFile.close();
     myFileOpened = false;
   }
-#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -216,12 +204,12 @@ void KidVid::setNextSong()
     mySharedData = (temp < 10);
     mySongCounter = ourSongStart[temp+1] - ourSongStart[temp];
 
-#if 0
-    if(mySharedData)
-      ; // fseek(mySharedSampleFile, ourSongStart[temp], SEEK_SET);
-    else
-      ; // fseek(mySampleFile, ourSongStart[temp], SEEK_SET);
-#endif
+    // Position the file at the start of the song; the samples are read
+    // from there in blocks
+    std::ifstream& file = mySharedData ? mySharedSampleFile : mySampleFile;
+    file.clear();
+    file.seekg(ourSongStart[temp]);
+    mySampleBlockPos = mySampleBlockSize = 0;
 
     ++myFilePointer;
     myTapeBusy = true;
@@ -237,33 +225,55 @@ void KidVid::setNextSong()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void KidVid::getNextSampleByte()
 {
-//  static int oddeven = 0;
   if(mySongCounter == 0)
     mySampleByte = 0x80;
-#if 0
   else
   {
-    oddeven = oddeven^1;
-    if(oddeven & 1)
+    // The tape delivers one sample byte for every two TIA samples
+    myOddEven = !myOddEven;
+    if(myOddEven)
     {
       mySongCounter--;
       myTapeBusy = (mySongCounter > 262*48) || !myBeep;
 
-      if(myFileOpened)
-      {
-        if(mySharedData)
-          mySampleByte = getc(mySharedSampleFile);
-        else
-          mySampleByte = getc(mySampleFile);
-      }
-      else
-        mySampleByte = 0x80;
+      mySampleByte = myFileOpened ? readSampleByte() : 0x80;
 
       if(!myBeep && (mySongCounter == 0))
         setNextSong();
     }
   }
-#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 KidVid::readSampleByte()
+{
+  if(mySampleBlockPos == mySampleBlockSize)
+  {
+    // Never read beyond the end of the current song
+    std::ifstream& file = mySharedData ? mySharedSampleFile : mySampleFile;
+    const uInt32 remaining = mySongCounter + 1;
+    file.read(reinterpret_cast<char*>(mySampleBlock.data()),
+              remaining < SAMPLE_BLOCK_SIZE ? remaining : SAMPLE_BLOCK_SIZE);
+
+    mySampleBlockPos = 0;
+    mySampleBlockSize = uInt32(file.gcount());
+    if(mySampleBlockSize == 0)
+      return 0x80;
+  }
+
+  return mySampleBlock[mySampleBlockPos++];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KidVid::generateAudio(Int16* samples, uInt32 count)
+{
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    getNextSampleByte();
+
+    // Unsigned 8 bit WAV data
+    samples[i] = Int16((Int32(mySampleByte) - 0x80) << 7);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
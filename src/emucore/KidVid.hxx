@@ -18,7 +18,7 @@
 #ifndef KIDVID_HXX
 #define KIDVID_HXX
 
-#include <cstdio>
+#include <fstream>
 
 class Event;
 
@@ -32,6 +32,9 @@ class Event;
 
     http://www.atariage.com/2600/archives/KidVidAudio/index.html
 
+  The files are expected in the sample directory (the base directory of
+  Stella).  They are streamed in blocks and mixed into the TIA audio.
+
   This code was heavily borrowed from z26.
 
   @author  Stephen Anthony & z26 team
@@ -46,9 +49,10 @@ class KidVid : public Controller
       @param event  The event object to use for events
       @param system The system using this controller
       @param romMd5 The md5 of the ROM using this controller
+      @param sampleDir The directory containing the WAV sample files
     */
     KidVid(Jack jack, const Event& event, const System& system,
-           const string& romMd5);
+           const string& romMd5, const string& sampleDir);
     virtual ~KidVid();
 
   public:
@@ -63,6 +67,16 @@ class KidVid : public Controller
     */
     string name() const override { return "KidVid"; }
 
+    /**
+      The tape audio is mixed into the TIA output.
+    */
+    bool hasAudio() const override { return myEnabled; }
+
+    /**
+      Generate the next samples of the tape audio.
+    */
+    void generateAudio(Int16* samples, uInt32 count) override;
+
   private:
     // Open/close a WAV sample file
     void openSampleFile();
@@ -72,9 +86,12 @@ class KidVid : public Controller
     void setNextSong();
 
     // Generate next sample byte
-    // TODO - rework this, perhaps send directly to sound class
     void getNextSampleByte();
 
+    // Read the next byte of the current song, refilling the sample block
+    // from the file when necessary
+    uInt8 readSampleByte();
+
   private:
     static constexpr uInt32
       KVSMURFS = 0x44,
@@ -82,15 +99,23 @@ class KidVid : public Controller
       KVBLOCKS = 6,             // number of bytes / block
       KVBLOCKBITS = KVBLOCKS*8, // number of bits / block
       SONG_POS_SIZE   = 44+38+42+62+80+62,
-      SONG_START_SIZE = 104
+      SONG_START_SIZE = 104,
+      SAMPLE_BLOCK_SIZE = 4096  // number of bytes read from a file at once
     ;
 
     // Whether the KidVid device is enabled (only for games that it
     // supports, and if it's plugged into the right port
     bool myEnabled{false};
 
+    // The directory containing the WAV files
+    string mySampleDir;
+
     // The file handles for the WAV files
-    // FILE *mySampleFile, *mySharedSampleFile;
+    std::ifstream mySampleFile, mySharedSampleFile;
+
+    // The block of the current file read most recently
+    std::array<uInt8, SAMPLE_BLOCK_SIZE> mySampleBlock;
+    uInt32 mySampleBlockPos{0}, mySampleBlockSize{0};
 
     // Indicates if sample files have been successfully opened
     bool myFileOpened{false};
@@ -100,7 +125,8 @@ class KidVid : public Controller
 
     uInt32 myFilePointer{0}, mySongCounter{0};
     bool myBeep{false}, mySharedData{false};
-    uInt8 mySampleByte{0};
+    uInt8 mySampleByte{0x80};
+    bool myOddEven{false};
     uInt32 myGame{0}, myTape{0};
     uInt32 myIdx{0}, myBlock{0}, myBlockIdx{0};
 
@@ -54,6 +54,8 @@ class M6502 : public Serializable
   // The 6502 and Cart debugger classes are friends who need special access
   friend class CartDebug;
   friend class CpuDebug;
+  // The regression runner compares the registers to known good values
+  friend class ProfilingRunner;
 
   public:
 
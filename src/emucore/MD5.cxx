@@ -352,4 +352,43 @@ string hash(const FilesystemNode& node)
   return md5;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool fromString(const string& md5, Digest& digest)
+{
+  if(md5.length() != 32)
+    return false;
+
+  uInt64 half[2] = { 0, 0 };
+  for(int t = 0; t < 32; ++t)
+  {
+    const char c = md5[t];
+    uInt64 nibble;
+    if(c >= '0' && c <= '9')       nibble = c - '0';
+    else if(c >= 'a' && c <= 'f')  nibble = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F')  nibble = c - 'A' + 10;
+    else                           return false;
+
+    half[t >> 4] = (half[t >> 4] << 4) | nibble;
+  }
+  digest.hi = half[0];
+  digest.lo = half[1];
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string toString(const Digest& digest)
+{
+  static constexpr char hex[] = "0123456789abcdef";
+
+  string result(32, '0');
+  for(int t = 0; t < 16; ++t)
+  {
+    result[15 - t] = hex[(digest.hi >> (t * 4)) & 0x0f];
+    result[31 - t] = hex[(digest.lo >> (t * 4)) & 0x0f];
+  }
+
+  return result;
+}
+
 }  // Namespace MD5
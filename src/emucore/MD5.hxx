@@ -24,6 +24,28 @@ class FilesystemNode;
 
 namespace MD5 {
 
+/**
+  The binary form of a message-digest, used as a compact lookup key.
+  'hi' contains the first 16 hexadecimal digits, 'lo' the last 16.
+*/
+struct Digest {
+  uInt64 hi{0}, lo{0};
+
+  bool operator==(const Digest& other) const {
+    return hi == other.hi && lo == other.lo;
+  }
+  bool operator<(const Digest& other) const {
+    return hi < other.hi || (hi == other.hi && lo < other.lo);
+  }
+};
+
+struct DigestHash {
+  size_t operator()(const Digest& d) const {
+    // The digest bits are already evenly distributed
+    return size_t(d.hi ^ d.lo);
+  }
+};
+
 /**
   Get the MD5 Message-Digest of the specified message with the
   given length.  The digest consists of 32 hexadecimal digits.
@@ -49,6 +71,24 @@ string hash(const uInt8* buffer, size_t length);
 */
 string hash(const FilesystemNode& node);
 
+/**
+  Convert a message-digest of 32 hexadecimal digits (in any case) into
+  its binary form.
+
+  @param md5     The message-digest
+  @param digest  The binary message-digest
+  @return  False if 'md5' is not a valid message-digest, else true
+*/
+bool fromString(const string& md5, Digest& digest);
+
+/**
+  Convert a binary message-digest into 32 lowercase hexadecimal digits.
+
+  @param digest  The binary message-digest
+  @return  The message-digest
+*/
+string toString(const Digest& digest);
+
 }  // Namespace MD5
 
 #endif
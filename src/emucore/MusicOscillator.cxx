@@ -0,0 +1,60 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cmath>
+
+#include "MusicOscillator.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MusicOscillator::save(Serializer& out) const
+{
+  try
+  {
+    // The fractional clocks are stored as a double, for compatibility with
+    // states saved by older versions
+    out.putLong(myCycles);
+    out.putDouble(double(myRemainder) / CPU_CLOCK_DIVIDEND);
+  }
+  catch(...)
+  {
+    cerr << "ERROR: MusicOscillator::save" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MusicOscillator::load(Serializer& in)
+{
+  try
+  {
+    myCycles = in.getLong();
+
+    const double fraction = in.getDouble();
+    myRemainder = fraction > 0
+      ? std::min(uInt64(std::llround(fraction * CPU_CLOCK_DIVIDEND)), CPU_CLOCK_DIVIDEND - 1)
+      : 0;
+  }
+  catch(...)
+  {
+    cerr << "ERROR: MusicOscillator::load" << endl;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,155 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef MUSIC_OSCILLATOR_HXX
+#define MUSIC_OSCILLATOR_HXX
+
+#include "bspf.hxx"
+#include "Serializable.hxx"
+
+/**
+  The music oscillator of the DPC, DPC+, CDF, BUS and CTY coprocessors.
+
+  The oscillator runs at a fixed 'pitch' (in Hz), independent of the 6507.
+  Since the music data fetchers are only observable when the music registers
+  are read, the oscillator is advanced lazily at these points, by the number
+  of whole oscillator clocks that passed since the previous read.
+
+  The number of clocks is calculated in fixed point, as a ratio of integers,
+  with the remainder carried over to the next update.  The ratio reproduces
+  the 6507 clock assumed by the coprocessor drivers (1193191.66666667 Hz)
+  exactly, so no precision is lost over time.
+*/
+class MusicOscillator : public Serializable
+{
+  public:
+    /**
+      Create a new oscillator.
+
+      @param pitch  The frequency of the oscillator (in Hz)
+    */
+    explicit MusicOscillator(uInt32 pitch = DEFAULT_PITCH) { setPitch(pitch); }
+    ~MusicOscillator() override = default;
+
+  public:
+    /**
+      Reset the oscillator.
+    */
+    void reset() { myCycles = myRemainder = 0; }
+
+    /**
+      Change the frequency of the oscillator.
+
+      @param pitch  The new frequency (in Hz)
+    */
+    void setPitch(uInt32 pitch)
+    {
+      myIncrement = uInt64(std::max(pitch, 1U)) * CPU_CLOCK_DIVISOR;
+      myMaxCycles = (~uInt64(0) - CPU_CLOCK_DIVIDEND) / myIncrement;
+    }
+
+    /**
+      Advance the oscillator to the given system cycle.
+
+      @param cycles  The current system cycle count
+      @return  The number of whole oscillator clocks since the last update
+    */
+    uInt32 update(uInt64 cycles)
+    {
+      uInt64 elapsed = cycles - myCycles;
+      uInt32 clocks = 0;
+      myCycles = cycles;
+
+      // Very long intervals are split, so the products cannot overflow
+      while(elapsed > myMaxCycles)
+      {
+        clocks += advanceCycles(myMaxCycles);
+        elapsed -= myMaxCycles;
+      }
+
+      return clocks + advanceCycles(elapsed);
+    }
+
+    /**
+      Advance the music counters of a three voice music coprocessor by the
+      given number of oscillator clocks.
+
+      @param counters     The phase accumulators of the voices
+      @param frequencies  The phase increments of the voices
+      @param clocks       The number of oscillator clocks
+    */
+    static void advance(std::array<uInt32, 3>& counters,
+                        const std::array<uInt32, 3>& frequencies, uInt32 clocks)
+    {
+      if(clocks > 0)
+        for(int x = 0; x <= 2; ++x)
+          counters[x] += frequencies[x] * clocks;
+    }
+
+    /**
+      Serializable methods (see that class for more information).
+    */
+    bool save(Serializer& out) const override;
+    bool load(Serializer& in) override;
+
+  public:
+    // The default frequency of all music coprocessors
+    static constexpr uInt32 DEFAULT_PITCH = 20000;
+
+  private:
+    /**
+      Advance the remainder by the given number of cycles and return the
+      number of whole clocks.
+    */
+    uInt32 advanceCycles(uInt64 cycles)
+    {
+      const uInt64 fraction = cycles * myIncrement + myRemainder;
+      myRemainder = fraction % CPU_CLOCK_DIVIDEND;
+
+      return uInt32(fraction / CPU_CLOCK_DIVIDEND);
+    }
+
+  private:
+    // The CPU clock assumed by the coprocessor drivers, as a ratio:
+    // 1193191.66666667 Hz = 119319166666667 / 100000000 Hz
+    static constexpr uInt64 CPU_CLOCK_DIVIDEND = 119319166666667ULL;
+    static constexpr uInt64 CPU_CLOCK_DIVISOR = 100000000ULL;
+
+  private:
+    // The fractional clocks added per system cycle, in units of
+    // 1 / CPU_CLOCK_DIVIDEND clocks (pitch * CPU_CLOCK_DIVISOR)
+    uInt64 myIncrement{0};
+
+    // The longest interval (in cycles) that can be processed in one step
+    uInt64 myMaxCycles{0};
+
+    // System cycle count from when the last update occurred
+    uInt64 myCycles{0};
+
+    // Fractional clocks unused during the last update, in units of
+    // 1 / CPU_CLOCK_DIVIDEND clocks
+    uInt64 myRemainder{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    MusicOscillator(const MusicOscillator&) = delete;
+    MusicOscillator(MusicOscillator&&) = delete;
+    MusicOscillator& operator=(const MusicOscillator&) = delete;
+    MusicOscillator& operator=(MusicOscillator&&) = delete;
+};
+
+#endif
@@ -35,6 +35,7 @@
   #include "CommandMenu.hxx"
   #include "MessageMenu.hxx"
   #include "Launcher.hxx"
+  #include "RomIndexer.hxx"
   #include "TimeMachine.hxx"
   #include "Widget.hxx"
 #endif
@@ -53,6 +54,7 @@
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "RomCache.hxx"
 #include "EventHandler.hxx"
 #include "PNGLibrary.hxx"
 #include "Console.hxx"
@@ -66,6 +68,7 @@
 #include "AudioSettings.hxx"
 #include "repository/KeyValueRepositoryNoop.hxx"
 #include "repository/KeyValueRepositoryConfigfile.hxx"
+#include "repository/KeyValueRepositoryWriteBehind.hxx"
 #include "M6532.hxx"
 
 #include "OSystem.hxx"
@@ -111,6 +114,9 @@ OSystem::OSystem()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OSystem::~OSystem()
 {
+  // Entries of deleted or renamed ROMs are dropped when the cache is saved
+  if(myRomCache)
+    myRomCache->removeMissing();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -143,10 +149,14 @@ bool OSystem::create()
   // Get relevant information about the video hardware
   // This must be done before any graphics context is created, since
   // it may be needed to initialize the size of graphical objects
+  auto start = high_resolution_clock::now();
   try        { myFrameBuffer = MediaFactory::createVideo(*this); }
   catch(...) { return false; }
   if(!myFrameBuffer->initialize())
     return false;
+  addStartupTime("video init", start);
+
+  start = high_resolution_clock::now();
 
   // Create the event handler for the system
   myEventHandler = MediaFactory::createEventHandler(*this);
@@ -176,14 +186,18 @@ bool OSystem::create()
   myMessageMenu = make_unique<MessageMenu>(*this);
   myTimeMachine = make_unique<TimeMachine>(*this);
   myLauncher = make_unique<Launcher>(*this);
+  myRomIndexer = make_unique<RomIndexer>(*myRomCache, *mySettings);
 #endif
 
 #ifdef PNG_SUPPORT
   // Create PNG handler
   myPNGLib = make_unique<PNGLibrary>(*this);
 #endif
+  addStartupTime("subsystems", start);
 
+  start = high_resolution_clock::now();
   myPropSet->load(myPropertiesFile);
+  addStartupTime("properties load", start);
 
   return true;
 }
@@ -191,6 +205,8 @@ bool OSystem::create()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::loadConfig(const Settings::Options& options)
 {
+  const auto start = high_resolution_clock::now();
+
   // Get base directory and config file from derived class
   // It will decide whether it can override its default location
   getBaseDirAndConfig(myBaseDir, myConfigFile,
@@ -222,8 +238,10 @@ void OSystem::loadConfig(const Settings::Options& options)
 #endif
 
   mySettings->setRepository(createSettingsRepository());
+  myRomCache = make_unique<RomCache>(createRomCacheRepository());
 
   mySettings->load(options);
+  addStartupTime("settings load", start);
 
   Logger::instance().setLogParameters(mySettings->getInt("loglevel"),
                                       mySettings->getBool("logtoconsole"));
@@ -403,6 +421,7 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
   }
 
   // Create an instance of the 2600 game console
+  const auto start = high_resolution_clock::now();
   ostringstream buf;
 
   myEventHandler->handleConsoleStartupEvents();
@@ -438,6 +457,7 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
       return "ERROR: Couldn't create framebuffer for console";
     }
     myConsole->initializeAudio();
+    myFrameTiming.setEnabled(mySettings->getBool("frametiming"));
 
     string saveOnExit = settings().getString("saveonexit");
     bool activeTM = settings().getBool(
@@ -470,6 +490,8 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
         myEventHandler->enterDebugMode();
     #endif
   }
+  addStartupTime("console creation", start);
+
   return EmptyString;
 }
 
@@ -498,6 +520,7 @@ bool OSystem::createLauncher(const string& startdir)
 
   mySettings->setValue("tmpromdir", startdir);
   bool status = false;
+  const auto start = high_resolution_clock::now();
 
 #ifdef GUI_SUPPORT
   myEventHandler->reset(EventHandlerState::LAUNCHER);
@@ -513,9 +536,46 @@ bool OSystem::createLauncher(const string& startdir)
 #endif
 
   myLauncherUsed = myLauncherUsed || status;
+  addStartupTime("launcher build", start);
+
   return status;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::addStartupTime(const string& phase,
+                             const high_resolution_clock::time_point& start)
+{
+  if(!myStartupFinished)
+    myStartupTimes.emplace_back(phase,
+      duration_cast<duration<double, std::milli>>(high_resolution_clock::now() - start).count());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::printStartupTimes()
+{
+  if(myStartupFinished)
+    return;
+  myStartupFinished = true;
+
+  if(mySettings->getBool("startuptime"))
+  {
+    ostringstream buf;
+    double total = 0;
+
+    buf << "Startup times:" << endl << std::fixed << std::setprecision(1);
+    for(const auto& phase: myStartupTimes)
+    {
+      buf << "  " << std::left << std::setw(18) << phase.first
+          << std::right << std::setw(8) << phase.second << " ms" << endl;
+      total += phase.second;
+    }
+    buf << "  " << std::left << std::setw(18) << "total"
+        << std::right << std::setw(8) << total << " ms" << endl;
+    cout << buf.str() << std::flush;
+  }
+  myStartupTimes.clear();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string OSystem::getROMInfo(const FilesystemNode& romfile)
 {
@@ -546,6 +606,13 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
 {
   unique_ptr<Console> console;
 
+  // Reuse the information derived from the ROM when it was last opened
+  RomCache::Entry cached = myRomCache->get(romfile);
+  if(md5 == "")
+    md5 = cached.md5;
+  else if(md5 != cached.md5)
+    cached = RomCache::Entry();
+
   // Open the cartridge image and read it in
   ByteBuffer image;
   size_t size = 0;
@@ -570,8 +637,8 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
     // Now create the cartridge
     string cartmd5 = md5;
     const string& type = props.get(PropType::Cart_Type);
-    unique_ptr<Cartridge> cart =
-      CartCreator::create(romfile, image, size, cartmd5, type, *mySettings);
+    unique_ptr<Cartridge> cart = CartCreator::create(romfile, image, size,
+        cartmd5, type, cached.bankswitch, *mySettings);
 
     // Some properties may not have a name set; we can't leave it blank
     if(props.get(PropType::Cart_Name) == EmptyString)
@@ -611,9 +678,22 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
     CMDLINE_PROPS_UPDATE("pxcenter", PropType::Controller_PaddlesXCenter);
     CMDLINE_PROPS_UPDATE("pycenter", PropType::Controller_PaddlesYCenter);
 
+    // The autodetection results for a part of a multicart depend on the
+    // part loaded, so these are only cached for the complete image
+    const bool cacheable = cartmd5 == md5;
+    if(!cacheable)
+      cached.leftController = cached.rightController = cached.displayFormat = "";
+
     // Finally, create the cart with the correct properties
     if(cart)
-      console = make_unique<Console>(*this, cart, props, *myAudioSettings);
+    {
+      console = make_unique<Console>(*this, cart, props, *myAudioSettings, cached);
+
+      if(cacheable)
+        cached = console->autodetected();
+      cached.md5 = md5;
+      myRomCache->set(romfile, cached);
+    }
   }
 
   return console;
@@ -628,10 +708,31 @@ void OSystem::closeConsole()
     // If a previous console existed, save cheats before creating a new one
     myCheatManager->saveCheats(myConsole->properties().get(PropType::Cart_MD5));
   #endif
+    saveFrameTiming();
     myConsole.reset();
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::saveFrameTiming()
+{
+  if(!myFrameTiming.enabled() ||
+     myFrameTiming.histogram(FrameTiming::Metric::present).count() == 0)
+    return;
+
+  const string path = myBaseDir + "frame_timing.csv";
+  ofstream out(path);
+  if(!out)
+  {
+    Logger::error("Unable to save frame timing to " + path);
+    return;
+  }
+
+  myFrameTiming.saveCSV(out);
+  myFrameTiming.reset();
+  Logger::info("Frame timing saved to " + path);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ByteBuffer OSystem::openROM(const FilesystemNode& rom, string& md5, size_t& size)
 {
@@ -687,6 +788,8 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   EmulationTiming& timing(myConsole->emulationTiming());
   DispatchResult dispatchResult;
 
+  tia.enableFramePublishing(false);
+
   // Check whether we have a frame pending for rendering...
   bool framePending = tia.newFramePending();
   // ... and copy it to the frame buffer. It is important to do this before
@@ -713,7 +816,61 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   // Stop the worker and wait until it has finished
   uInt64 totalCycles = emulationWorker.stop();
 
-  // Handle the dispatch result
+  handleDispatchResult(dispatchResult);
+
+  // Return the 6507 time used in seconds
+  return static_cast<double>(totalCycles) / static_cast<double>(timing.cyclesPerSecond());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::dispatchDecoupledEmulation(EmulationWorker& emulationWorker)
+{
+  if (!myConsole) return;
+
+  TIA& tia(myConsole->tia());
+  EmulationTiming& timing(myConsole->emulationTiming());
+  DispatchResult dispatchResult;
+  // The worker may be stopped before it is due to emulate anything
+  dispatchResult.setOk(0);
+
+  tia.enableFramePublishing(true);
+
+  // Take the latest frame and draw it, including the statistics overlay.
+  // The worker is still stopped, so the emulation state can be read safely.
+  const uInt32 frames = tia.renderPublishedFrame();
+  if (frames > 0) {
+    myFpsMeter.render(frames);
+    myFrameBuffer->renderEmulationFrame(myFpsMeter.fps());
+  }
+
+  // Resume emulation; the worker continues its own 6507 time
+  emulationWorker.start(
+    timing.cyclesPerSecond(),
+    timing.maxCyclesPerTimeslice(),
+    timing.minCyclesPerTimeslice(),
+    &dispatchResult,
+    &tia,
+    true
+  );
+
+  // Present the frame. This may block (vsync, driver), but only delays the
+  // presentation, not the emulation.
+  if (frames > 0)
+    myFrameBuffer->presentEmulationFrame();
+  else
+    // No new frame yet; check again in a quarter frame
+    std::this_thread::sleep_for(duration<double>(
+      0.25 * static_cast<double>(timing.cyclesPerFrame()) / static_cast<double>(timing.cyclesPerSecond())));
+
+  // Stop the worker while the events are handled
+  emulationWorker.stop();
+
+  handleDispatchResult(dispatchResult);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::handleDispatchResult(const DispatchResult& dispatchResult)
+{
   switch (dispatchResult.getStatus()) {
     case DispatchResult::Status::ok:
       break;
@@ -744,9 +901,6 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   // Handle frying
   if (dispatchResult.getStatus() == DispatchResult::Status::ok && myEventHandler->frying())
     myConsole->fry();
-
-  // Return the 6507 time used in seconds
-  return static_cast<double>(totalCycles) / static_cast<double>(timing.cyclesPerSecond());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -755,7 +909,9 @@ void OSystem::mainLoop()
   // 6507 time
   time_point<high_resolution_clock> virtualTime = high_resolution_clock::now();
   // The emulation worker
-  EmulationWorker emulationWorker;
+  EmulationWorker emulationWorker(myFrameTiming);
+  // Looked up once, instead of on each iteration
+  const Settings::Handle decoupled = mySettings->handle("decoupled");
 
   myFpsMeter.reset(TIAConstants::initialGarbageFrames);
 
@@ -763,16 +919,35 @@ void OSystem::mainLoop()
   {
     bool wasEmulation = myEventHandler->state() == EventHandlerState::EMULATION;
 
+    myFrameTiming.inputPolled();
     myEventHandler->poll(TimerManager::getTicks());
     if(myQuitLoop) break;  // Exit if the user wants to quit
 
     if (!wasEmulation && myEventHandler->state() == EventHandlerState::EMULATION) {
       myFpsMeter.reset();
+      myFrameTiming.resume();
       virtualTime = high_resolution_clock::now();
     }
 
+  #ifdef GUI_SUPPORT
+    // Leave the CPU to the emulation; otherwise store the indexed ROMs
+    if(myEventHandler->state() == EventHandlerState::EMULATION)
+      myRomIndexer->setPaused(true);
+    else
+    {
+      myRomIndexer->setPaused(false);
+      myRomIndexer->update();
+    }
+  #endif
+
     double timesliceSeconds;
 
+    if (myEventHandler->state() == EventHandlerState::EMULATION && mySettings->getBool(decoupled)) {
+      // The worker does its own pacing
+      dispatchDecoupledEmulation(emulationWorker);
+      continue;
+    }
+
     if (myEventHandler->state() == EventHandlerState::EMULATION)
       // Dispatch emulation and render frame (if applicable)
       timesliceSeconds = dispatchEmulation(emulationWorker);
@@ -810,16 +985,22 @@ void OSystem::mainLoop()
 
   myCheatManager->saveCheatDatabase();
 #endif
+  saveFrameTiming();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 shared_ptr<KeyValueRepository> OSystem::createSettingsRepository()
 {
   #ifdef SQLITE_SUPPORT
-    return mySettingsDb
-      ? shared_ptr<KeyValueRepository>(mySettingsDb, &mySettingsDb->settingsRepository())
-      : make_shared<KeyValueRepositoryNoop>();
+    // Changes are saved to the database in the background, so that saving
+    // never blocks
+    if (!mySettingsDb)
+      return make_shared<KeyValueRepositoryNoop>();
+
+    return make_shared<KeyValueRepositoryWriteBehind>(shared_ptr<KeyValueRepository>(
+      mySettingsDb, &mySettingsDb->settingsRepository()));
   #else
+    // The config file is only written when Stella exits (see saveConfig)
     if (myConfigFile.empty())
       return make_shared<KeyValueRepositoryNoop>();
 
@@ -827,6 +1008,21 @@ shared_ptr<KeyValueRepository> OSystem::createSettingsRepository()
   #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepository> OSystem::createRomCacheRepository()
+{
+  #ifdef SQLITE_SUPPORT
+    if (!mySettingsDb)
+      return make_shared<KeyValueRepositoryNoop>();
+
+    return make_shared<KeyValueRepositoryWriteBehind>(shared_ptr<KeyValueRepository>(
+      mySettingsDb, &mySettingsDb->romCacheRepository()));
+  #else
+    // Without a database, the cache only lasts for the session
+    return make_shared<KeyValueRepositoryNoop>();
+  #endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string OSystem::ourOverrideBaseDir = "";
 bool OSystem::ourOverrideBaseDirWithApp = false;
@@ -23,11 +23,13 @@ class FrameBuffer;
 class EventHandler;
 class Properties;
 class PropertiesSet;
+class RomCache;
 class Random;
 class Sound;
 class StateManager;
 class TimerManager;
 class EmulationWorker;
+class DispatchResult;
 class AudioSettings;
 #ifdef CHEATCODE_SUPPORT
   class CheatManager;
@@ -40,6 +42,7 @@ class AudioSettings;
   class Launcher;
   class Menu;
   class MessageMenu;
+  class RomIndexer;
   class TimeMachine;
   class VideoAudioDialog;
 #endif
@@ -56,6 +59,7 @@ class AudioSettings;
 #include "FrameBufferConstants.hxx"
 #include "EventHandlerConstants.hxx"
 #include "FpsMeter.hxx"
+#include "FrameTiming.hxx"
 #include "Settings.hxx"
 #include "Logger.hxx"
 #include "bspf.hxx"
@@ -104,6 +108,13 @@ class OSystem
     */
     FrameBuffer& frameBuffer() const { return *myFrameBuffer; }
 
+    /**
+      Get the frame pacing statistics of the system.
+
+      @return The frame timing object
+    */
+    FrameTiming& frameTiming() { return myFrameTiming; }
+
     /**
       Get the sound object of the system.
 
@@ -132,6 +143,13 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of the information derived from ROM files.
+
+      @return The ROM cache object
+    */
+    RomCache& romCache() const { return *myRomCache; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -223,6 +241,13 @@ class OSystem
     */
     Launcher& launcher() const { return *myLauncher; }
 
+    /**
+      Get the background indexer of ROM directories.
+
+      @return The ROM indexer object
+    */
+    RomIndexer& romIndexer() const { return *myRomIndexer; }
+
     /**
       Get the time machine of the system (manages state files).
 
@@ -369,6 +394,13 @@ class OSystem
     */
     bool launcherUsed() const { return myLauncherUsed; }
 
+    /**
+      Print how long the phases of the startup (settings, video, properties,
+      launcher or console) took, if enabled with 'startuptime'. Later calls
+      do nothing, since startup is over.
+    */
+    void printStartupTimes();
+
     /**
       Gets all possible info about the ROM by creating a temporary
       Console object and querying it.
@@ -439,6 +471,8 @@ class OSystem
 
     virtual shared_ptr<KeyValueRepository> createSettingsRepository();
 
+    virtual shared_ptr<KeyValueRepository> createRomCacheRepository();
+
     //////////////////////////////////////////////////////////////////////
     // The following methods are system-specific and *must* be
     // implemented in derived classes.
@@ -482,6 +516,9 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the RomCache object
+    unique_ptr<RomCache> myRomCache;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -511,6 +548,9 @@ class OSystem
     // Pointer to the Launcher object
     unique_ptr<Launcher> myLauncher;
 
+    // Pointer to the RomIndexer object
+    unique_ptr<RomIndexer> myRomIndexer;
+
     // Pointer to the TimeMachine object
     unique_ptr<TimeMachine> myTimeMachine;
   #endif
@@ -555,6 +595,11 @@ class OSystem
 
     static constexpr uInt32 FPS_METER_QUEUE_SIZE = 100;
     FpsMeter myFpsMeter{FPS_METER_QUEUE_SIZE};
+    FrameTiming myFrameTiming;
+
+    // The duration (in ms) of each startup phase, until printStartupTimes()
+    vector<std::pair<string, double>> myStartupTimes;
+    bool myStartupFinished{false};
 
     // If not empty, a hint for derived classes to use this as the
     // base directory (where all settings are stored)
@@ -587,6 +632,17 @@ class OSystem
     */
     void closeConsole();
 
+    /**
+      Save the frame pacing statistics (if any) as CSV and clear them.
+    */
+    void saveFrameTiming();
+
+    /**
+      Record the duration of a startup phase, which began at 'start'.
+    */
+    void addStartupTime(const string& phase,
+                        const std::chrono::high_resolution_clock::time_point& start);
+
     /**
       Gets all possible info about the given console.
 
@@ -597,6 +653,19 @@ class OSystem
 
     double dispatchEmulation(EmulationWorker& emulationWorker);
 
+    /**
+      Decoupled emulation: the worker keeps running and does its own pacing,
+      while the main thread presents the latest published frame.  The worker
+      is only stopped while events are handled.
+    */
+    void dispatchDecoupledEmulation(EmulationWorker& emulationWorker);
+
+    /**
+      Start the debugger or fry the console, depending on the result of an
+      emulation run.
+    */
+    void handleDispatchResult(const DispatchResult& dispatchResult);
+
     // Following constructors and assignment operators not supported
     OSystem(const OSystem&) = delete;
     OSystem(OSystem&&) = delete;
@@ -15,11 +15,16 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
+#include "Bankswitch.hxx"
 #include "Cart.hxx"
 #include "CartCreator.hxx"
 #include "MD5.hxx"
@@ -31,16 +36,20 @@
 #include "FrameManager.hxx"
 #include "FrameLayoutDetector.hxx"
 #include "EmulationTiming.hxx"
-#include "ConsoleTiming.hxx"
 #include "System.hxx"
 #include "Joystick.hxx"
 #include "Random.hxx"
 #include "DispatchResult.hxx"
+#include "AudioQueue.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
+#include "XXH64.hxx"
 
 using namespace std::chrono;
 
 namespace {
   static constexpr uInt32 RUNTIME_DEFAULT = 60;
+  static constexpr uInt32 FRAMES_DEFAULT = 600;
 
   void updateProgress(uInt32 from, uInt32 to) {
     while (from < to) {
@@ -54,31 +63,175 @@ namespace {
   }
 }
 
+/**
+  The cartridge and the chips of a console, wired up and reset.  Each machine
+  has its own settings, so several machines can run in parallel.
+*/
+struct ProfilingRunner::Machine
+{
+  Settings settings;
+  Properties props;
+  IO consoleIO;
+  Random rng{0};
+  Event event;
+  FrameManager frameManager;
+
+  unique_ptr<Cartridge> cartridge;
+  unique_ptr<M6502> cpu;
+  unique_ptr<M6532> riot;
+  unique_ptr<TIA> tia;
+  unique_ptr<System> system;
+
+  unique_ptr<EmulationTiming> emulationTiming;
+  shared_ptr<AudioQueue> audioQueue;
+
+  FrameLayout frameLayout{FrameLayout::ntsc};
+
+  /**
+    Load the ROM and power up the console.
+
+    @return  An error message, or the empty string on success
+  */
+  string load(const string& romFile);
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ProfilingRunner::Machine::load(const string& romFile)
+{
+  FilesystemNode imageFile(romFile);
+
+  if (!imageFile.isFile())
+    return romFile + " is not a ROM image";
+
+  ByteBuffer image;
+  size_t size = imageFile.read(image);
+  if (size == 0)
+    return "unable to read " + romFile;
+
+  settings.setValue("fastscbios", true);
+
+  string md5 = MD5::hash(image, size);
+  string type = "", autodetected = "";
+  cartridge = CartCreator::create(imageFile, image, size, md5, type,
+                                  autodetected, settings);
+
+  if (!cartridge)
+    return "unable to determine cartridge type";
+
+  cpu = make_unique<M6502>(settings);
+  riot = make_unique<M6532>(consoleIO, settings);
+  tia = make_unique<TIA>(consoleIO, []() { return ConsoleTiming::ntsc; }, settings);
+  system = make_unique<System>(rng, *cpu, *riot, *tia, *cartridge);
+
+  consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, *system);
+  consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, *system);
+  consoleIO.mySwitches = make_unique<Switches>(event, props, settings);
+
+  tia->bindToControllers();
+  cartridge->setStartBankFromPropsFunc([]() { return -1; });
+  system->initialize();
+
+  FrameLayoutDetector frameLayoutDetector;
+  tia->setFrameManager(&frameLayoutDetector);
+  system->reset();
+
+  for(int i = 0; i < 60; ++i) tia->update();
+
+  frameLayout = frameLayoutDetector.detectedLayout();
+  const ConsoleTiming consoleTiming =
+    frameLayout == FrameLayout::pal ? ConsoleTiming::pal : ConsoleTiming::ntsc;
+
+  tia->setFrameManager(&frameManager);
+  tia->setLayout(frameLayout);
+
+  system->reset();
+
+  emulationTiming = make_unique<EmulationTiming>(frameLayout, consoleTiming);
+
+  // The audio is not played, but hashed together with the frames; this allows
+  // comparing the output of different builds
+  audioQueue = make_shared<AudioQueue>(
+    emulationTiming->audioFragmentSize(), emulationTiming->audioQueueCapacity(), false);
+  audioQueue->ignoreOverflows(true);
+  tia->setAudioQueue(audioQueue);
+  tia->enableHashing(true);
+
+  return EmptyString;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns(std::max(argc - 2, 0))
+  : myIsRegression(argc > 1 && (string(argv[1]) == "-regress" ||
+                                 string(argv[1]) == "-regress-update")),
+    myUpdateGoldens(argc > 1 && string(argv[1]) == "-regress-update")
 {
-  for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
+  int first = 2;
+
+  if (myIsRegression && argc > 2) {
+    myGoldenFile = argv[2];
+    first = 3;
+  }
 
+  for (int i = first; i < argc; i++) {
     string arg = argv[i];
     size_t splitPoint = arg.find_first_of(':');
 
-    run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+    const string romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+    const uInt32 defaultRuntime = myIsRegression ? FRAMES_DEFAULT : RUNTIME_DEFAULT;
+    uInt32 runtime = defaultRuntime;
 
-    if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
-    else  {
-      int runtime = BSPF::stringToInt(arg.substr(splitPoint+1, string::npos));
-      run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
+    if (splitPoint != string::npos) {
+      int value = BSPF::stringToInt(arg.substr(splitPoint+1, string::npos));
+      runtime = value > 0 ? value : defaultRuntime;
     }
+
+    if (myIsRegression) {
+      // Goldens are keyed by the path relative to the given directory, so
+      // that they match however the directory is specified
+      const FilesystemNode node(romFile);
+      string root = EmptyString;
+      if (node.isDirectory()) {
+        root = node.getPath();
+        if (root.back() != '/' && root.back() != '\\') root += '/';
+      }
+      addRegressionRuns(node, runtime, root);
+    }
+    else
+      profilingRuns.push_back({romFile, runtime, romFile});
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::addRegressionRuns(const FilesystemNode& node, uInt32 frames,
+                                        const string& root)
+{
+  if (!node.isDirectory()) {
+    string key = root.empty() ? node.getName() : node.getPath().substr(root.length());
+    std::replace(key.begin(), key.end(), '\\', '/');
+
+    profilingRuns.push_back({node.getPath(), frames, key});
+    return;
   }
 
-  mySettings.setValue("fastscbios", true);
+  FSList files;
+  node.getChildren(files, FilesystemNode::ListMode::All,
+    [](const FilesystemNode& child) {
+      return child.isDirectory() || Bankswitch::isValidRomName(child);
+    }, false);
+  std::sort(files.begin(), files.end(),
+    [](const FilesystemNode& a, const FilesystemNode& b) {
+      return a.getPath() < b.getPath();
+    });
+
+  for (const auto& file: files)
+    addRegressionRuns(file, frames, root);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::run()
 {
+  if (myIsRegression) return runRegression();
+
   cout << "Profiling Stella..." << endl;
 
   for (ProfilingRun& run : profilingRuns) {
@@ -93,80 +246,20 @@ bool ProfilingRunner::run()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::runOne(const ProfilingRun& run)
 {
-  FilesystemNode imageFile(run.romFile);
-
-  if (!imageFile.isFile()) {
-    cout << "ERROR: " << run.romFile << " is not a ROM image" << endl;
-    return false;
-  }
+  Machine machine;
 
-  ByteBuffer image;
-  size_t size = imageFile.read(image);
-  if (size == 0) {
-    cout << "ERROR: unable to read " << run.romFile << endl;
+  const string error = machine.load(run.romFile);
+  if (error != EmptyString) {
+    cout << "ERROR: " << error << endl;
     return false;
   }
 
-  string md5 = MD5::hash(image, size);
-  string type = "";
-  unique_ptr<Cartridge> cartridge = CartCreator::create(
-      imageFile, image, size, md5, type, mySettings);
-
-  if (!cartridge) {
-    cout << "ERROR: unable to determine cartridge type" << endl;
-    return false;
-  }
-
-  IO consoleIO;
-  Random rng(0);
-  Event event;
-
-  M6502 cpu(mySettings);
-  M6532 riot(consoleIO, mySettings);
-  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, mySettings);
-  System system(rng, cpu, riot, tia, *cartridge);
-
-  consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
-  consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
-  consoleIO.mySwitches = make_unique<Switches>(event, myProps, mySettings);
-
-  tia.bindToControllers();
-  cartridge->setStartBankFromPropsFunc([]() { return -1; });
-  system.initialize();
-
-  FrameLayoutDetector frameLayoutDetector;
-  tia.setFrameManager(&frameLayoutDetector);
-  system.reset();
-
-  (cout << "detecting frame layout... ").flush();
-  for(int i = 0; i < 60; ++i) tia.update();
-
-  FrameLayout frameLayout = frameLayoutDetector.detectedLayout();
-  ConsoleTiming consoleTiming = ConsoleTiming::ntsc;
-
-  switch (frameLayout) {
-    case FrameLayout::ntsc:
-      cout << "NTSC";
-      consoleTiming = ConsoleTiming::ntsc;
-      break;
-
-    case FrameLayout::pal:
-      cout << "PAL";
-      consoleTiming = ConsoleTiming::pal;
-      break;
-  }
-
+  cout << "frame layout: " << (machine.frameLayout == FrameLayout::pal ? "PAL" : "NTSC");
   (cout << endl).flush();
 
-  FrameManager frameManager;
-  tia.setFrameManager(&frameManager);
-  tia.setLayout(frameLayout);
-
-  system.reset();
-
-  EmulationTiming emulationTiming(frameLayout, consoleTiming);
+  TIA& tia = *machine.tia;
   uInt64 cycles = 0;
-  uInt64 cyclesTarget = uInt64(run.runtime) * emulationTiming.cyclesPerSecond();
+  uInt64 cyclesTarget = uInt64(run.runtime) * machine.emulationTiming->cyclesPerSecond();
 
   DispatchResult dispatchResult;
   dispatchResult.setOk(0);
@@ -197,6 +290,193 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
 
   (cout << "100%" << endl).flush();
   cout << "real time: " << realtimeUsed << " seconds" << endl;
+  cout << "frames: " << tia.frameCount() << ", last frame hash: " << XXH64::toString(tia.frameHash()) << endl;
+  cout << "video hash: " << XXH64::toString(tia.videoHash())
+       << ", audio hash: " << XXH64::toString(tia.audioHash()) << endl;
 
   return true;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ProfilingRunner::RegressionResult
+ProfilingRunner::runRegressionOne(const ProfilingRun& run) const
+{
+  RegressionResult result;
+
+  try
+  {
+    Machine machine;
+
+    result.error = machine.load(run.romFile);
+    if (result.error != EmptyString) return result;
+
+    TIA& tia = *machine.tia;
+    uInt64 cycles = 0;
+
+    DispatchResult dispatchResult;
+    dispatchResult.setOk(0);
+
+    time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+    while (tia.frameCount() < run.runtime && dispatchResult.getStatus() == DispatchResult::Status::ok) {
+      tia.update(dispatchResult);
+      cycles += dispatchResult.getCycles();
+
+      if (tia.newFramePending()) tia.renderToFrameBuffer();
+    }
+
+    result.realtime = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+
+    result.frames = tia.frameCount();
+    result.emulatedTime = double(cycles) / machine.emulationTiming->cyclesPerSecond();
+
+    const M6502& cpu = *machine.cpu;
+    std::ostringstream buf;
+    buf << XXH64::toString(tia.videoHash()) << '\t'
+        << XXH64::toString(tia.audioHash()) << '\t'
+        << XXH64::toString(XXH64::hash(machine.riot->getRAM(), 128)) << '\t'
+        << std::hex << std::uppercase << std::setfill('0')
+        << "A=" << std::setw(2) << int(cpu.A) << " X=" << std::setw(2) << int(cpu.X)
+        << " Y=" << std::setw(2) << int(cpu.Y) << " SP=" << std::setw(2) << int(cpu.SP)
+        << " PS=" << std::setw(2) << int(cpu.PS()) << " PC=" << std::setw(4) << cpu.PC;
+
+    // Some ROMs stop the emulation (e.g. on illegal instructions); this is
+    // deterministic, so it becomes part of the signature
+    if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
+      string message = dispatchResult.getMessage();
+      std::replace(message.begin(), message.end(), '\n', ' ');
+      buf << "\tstopped after " << std::dec << cycles << " cycles: " << message;
+    }
+
+    result.signature = buf.str();
+  }
+  catch(const std::exception& e)
+  {
+    result.error = e.what();
+  }
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runRegression()
+{
+  if (myGoldenFile == EmptyString || profilingRuns.empty()) {
+    cout << "usage: stella -regress[-update] <golden file> <rom or directory>[:frames] ..." << endl;
+    return false;
+  }
+
+  // The golden file has one line per ROM:  key, frames and signature,
+  // separated by tabs.  Lines starting with '#' are comments.
+  std::map<string, string> goldens;
+  {
+    std::ifstream in(myGoldenFile);
+    string line;
+
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') continue;
+
+      const size_t tab = line.find('\t');
+      if (tab != string::npos) goldens[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+  }
+
+  const uInt32 numRuns = uInt32(profilingRuns.size());
+  const uInt32 numThreads = std::max(1U, std::min(std::thread::hardware_concurrency(), numRuns));
+
+  cout << "Running " << numRuns << " ROMs on " << numThreads << " thread(s)..." << endl;
+
+  vector<RegressionResult> results(numRuns);
+  std::atomic<uInt32> nextRun{0};
+  std::mutex outputMutex;
+  uInt32 passed = 0, failed = 0, missing = 0;
+
+  auto worker = [&]() {
+    for (uInt32 i = nextRun++; i < numRuns; i = nextRun++) {
+      const ProfilingRun& run = profilingRuns[i];
+      RegressionResult& result = results[i];
+
+      result = runRegressionOne(run);
+
+      std::ostringstream buf;
+      const string line = std::to_string(run.runtime) + '\t' + result.signature;
+      const auto golden = goldens.find(run.key);
+      uInt32* counter = &failed;
+
+      if (result.error != EmptyString)
+        buf << "ERROR " << run.romFile << ": " << result.error;
+      else {
+        if (golden == goldens.end()) {
+          buf << "NEW   ";
+          counter = &missing;
+        }
+        else if (golden->second != line)
+          buf << "FAIL  ";
+        else {
+          buf << "ok    ";
+          counter = &passed;
+        }
+
+        buf << run.romFile << ": " << result.frames << " frames, " << std::fixed
+            << std::setprecision(0) << (result.frames / std::max(result.realtime, 1e-6))
+            << " fps (" << std::setprecision(1)
+            << (result.emulatedTime / std::max(result.realtime, 1e-6)) << "x)";
+
+        if (golden != goldens.end() && golden->second != line)
+          buf << endl << "  expected " << golden->second << endl << "  got      " << line;
+      }
+
+      std::lock_guard<std::mutex> lock(outputMutex);
+      ++*counter;
+      cout << buf.str() << endl;
+    }
+  };
+
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  vector<std::thread> threads;
+  for (uInt32 i = 1; i < numThreads; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread: threads) thread.join();
+
+  double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+
+  // The time spent by all threads together
+  uInt64 frames = 0;
+  double threadTime = 0;
+  for (const auto& result: results) {
+    frames += result.frames;
+    threadTime += result.realtime;
+  }
+
+  cout << endl << passed << " passed, " << failed << " failed, " << missing << " new" << endl
+       << frames << " frames in " << std::fixed << std::setprecision(2) << realtimeUsed
+       << " seconds (" << std::setprecision(0) << (frames / std::max(threadTime, 1e-6))
+       << " fps per thread, " << (frames / std::max(realtimeUsed, 1e-6)) << " fps total)" << endl;
+
+  // ROMs without golden fail, unless they are to be added; mismatches are
+  // never overwritten
+  if (missing > 0 && !myUpdateGoldens) {
+    cout << "run with -regress-update to add the new ROM(s) to " << myGoldenFile << endl;
+    return false;
+  }
+  if (missing > 0) {
+    for (uInt32 i = 0; i < numRuns; ++i)
+      if (results[i].error == EmptyString && goldens.count(profilingRuns[i].key) == 0)
+        goldens[profilingRuns[i].key] = std::to_string(profilingRuns[i].runtime) + '\t' + results[i].signature;
+
+    std::ofstream out(myGoldenFile);
+    if (!out) {
+      cout << "ERROR: unable to write " << myGoldenFile << endl;
+      return false;
+    }
+
+    out << "# Stella regression goldens: path, frames, video, audio, RAM, CPU" << endl;
+    for (const auto& golden: goldens)
+      out << golden.first << '\t' << golden.second << endl;
+
+    cout << "added " << missing << " ROM(s) to " << myGoldenFile << endl;
+  }
+
+  return failed == 0;
+}
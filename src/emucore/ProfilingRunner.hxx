@@ -18,13 +18,28 @@
 #ifndef PROFILING_RUNNER
 #define PROFILING_RUNNER
 
+class FilesystemNode;
+
 #include "bspf.hxx"
 #include "Control.hxx"
 #include "Switches.hxx"
-#include "Settings.hxx"
 #include "ConsoleIO.hxx"
-#include "Props.hxx"
 
+/**
+  Runs ROMs headless, without a frontend.  There are two modes:
+
+    stella -profile <rom>[:seconds] ...
+      Emulate each ROM for the given time and report the time it took.
+
+    stella -regress[-update] <golden file> <rom or directory>[:frames] ...
+      Emulate each ROM (directories are searched recursively) for the given
+      number of frames, in parallel on all cores.  The hashes of the video,
+      the audio, the RAM and the CPU registers at the end of the run are
+      compared to the golden file, and the emulation speed is reported.
+      ROMs are identified by their path relative to the given directory.
+      ROMs which are missing from the golden file fail the run; with
+      '-regress-update' they are added to it instead.
+*/
 class ProfilingRunner {
   public:
 
@@ -36,7 +51,16 @@ class ProfilingRunner {
 
     struct ProfilingRun {
       string romFile;
-      uInt32 runtime;
+      uInt32 runtime;  // seconds (profiling) or frames (regression)
+      string key;      // the name of the golden (regression)
+    };
+
+    struct RegressionResult {
+      string error;
+      uInt32 frames{0};
+      double realtime{0};      // seconds
+      double emulatedTime{0};  // seconds
+      string signature;        // video, audio, RAM and CPU; tab separated
     };
 
     struct IO: public ConsoleIO {
@@ -49,17 +73,28 @@ class ProfilingRunner {
       unique_ptr<Switches> mySwitches;
     };
 
+    // A headless console (defined in the implementation)
+    struct Machine;
+
   private:
 
     bool runOne(const ProfilingRun& run);
 
+    bool runRegression();
+
+    RegressionResult runRegressionOne(const ProfilingRun& run) const;
+
+    void addRegressionRuns(const FilesystemNode& node, uInt32 frames,
+                           const string& root);
+
   private:
 
     vector<ProfilingRun> profilingRuns;
 
-    Settings mySettings;
+    bool myIsRegression{false};
+    bool myUpdateGoldens{false};
 
-    Properties myProps;
+    string myGoldenFile;
 };
 
 #endif // PROFILING_RUNNER
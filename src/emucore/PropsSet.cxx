@@ -45,9 +45,13 @@ bool PropertiesSet::save(const string& filename) const
   if(!out)
     return false;
 
-  // Only save those entries in the external list
+  // Only save those entries in the external list, ordered by md5
+  std::map<MD5::Digest, const Properties*> sorted;
   for(const auto& i: myExternalProps)
-    out << i.second;
+    sorted.emplace(i.first, &i.second);
+
+  for(const auto& i: sorted)
+    out << *i.second;
 
   return true;
 }
@@ -59,6 +63,10 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
   properties.setDefaults();
   bool found = false;
 
+  MD5::Digest key;
+  if(!MD5::fromString(md5, key))
+    return false;
+
   // There are three lists to search when looking for a properties entry,
   // which must be done in the following order
   // If 'useDefaults' is specified, only use the built-in list
@@ -71,7 +79,7 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
   if(!useDefaults)
   {
     // Check external list
-    auto ext = myExternalProps.find(md5);
+    auto ext = myExternalProps.find(key);
     if(ext != myExternalProps.end())
     {
       properties = ext->second;
@@ -79,7 +87,7 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
     }
     else  // Search temp list
     {
-      auto tmp = myTempProps.find(md5);
+      auto tmp = myTempProps.find(key);
       if(tmp != myTempProps.end())
       {
         properties = tmp->second;
@@ -88,29 +96,14 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
+  // Otherwise, search the internal database
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    const Int32 slot = defPropsSlot(key);
+    if(slot >= 0)
     {
-      int i = (low + high) / 2;
-      int cmp = BSPF::compareIgnoreCase(md5,
-          DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)]);
-
-      if(cmp == 0)  // found it
-      {
-        for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropType(p), DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      loadDefProps(slot, properties);
+      found = true;
     }
   }
 
@@ -120,18 +113,14 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::insert(const Properties& properties, bool save)
 {
-  // Note that the following code is optimized for insertion when an item
-  // doesn't already exist, and when the external properties file is
-  // relatively small (which is the case with current versions of Stella,
-  // as the properties are built-in)
-  // If an item does exist, it will be removed and insertion done again
-  // This shouldn't be a speed issue, as insertions will only fail with
-  // duplicates when you're changing the current ROM properties, which
-  // most people tend not to do
+  // If an item already exists, it is overwritten
+  // This only happens when you're changing the current ROM properties,
+  // which most people tend not to do
 
   // Since the PropSet is keyed by md5, we can't insert without a valid one
   const string& md5 = properties.get(PropType::Cart_MD5);
-  if(md5 == "")
+  MD5::Digest key;
+  if(!MD5::fromString(md5, key))
     return;
 
   // Make sure the exact entry isn't already in any list
@@ -140,20 +129,14 @@ void PropertiesSet::insert(const Properties& properties, bool save)
     return;
   else if(getMD5(md5, defaultProps, true) && defaultProps == properties)
   {
-    myExternalProps.erase(md5);
+    myExternalProps.erase(key);
     return;
   }
 
   // The status of 'save' determines which list to save to
   PropsList& list = save ? myExternalProps : myTempProps;
 
-  auto ret = list.emplace(md5, properties);
-  if(ret.second == false)
-  {
-    // Remove old item and insert again
-    list.erase(ret.first);
-    list.emplace(md5, properties);
-  }
+  list[key] = properties;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -198,21 +181,21 @@ void PropertiesSet::print() const
   // This isn't fast, but I suspect this method isn't used too often (or at all)
 
   // First insert all external props
-  PropsList list = myExternalProps;
+  std::map<MD5::Digest, Properties> list(myExternalProps.begin(),
+                                         myExternalProps.end());
 
   // Now insert all the built-in ones
   // Note that if we try to insert a duplicate, the insertion will fail
   // This is fine, since a duplicate in the built-in list means it should
   // be overrided anyway (and insertion shouldn't be done)
   Properties properties;
-  for(uInt32 i = 0; i < DEF_PROPS_SIZE; ++i)
+  for(uInt32 slot = 0; slot < DEF_PROPS_SIZE; ++slot)
   {
     properties.setDefaults();
-    for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropType(p), DefProps[i][p]);
+    loadDefProps(slot, properties);
 
-    list.emplace(DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)], properties);
+    list.emplace(MD5::Digest{DefProps[slot].md5Hi, DefProps[slot].md5Lo},
+                 properties);
   }
 
   // Now, print the resulting list
@@ -220,3 +203,40 @@ void PropertiesSet::print() const
   for(const auto& i: list)
     i.second.print();
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 PropertiesSet::defPropsSlot(const MD5::Digest& md5)
+{
+  // 32-bit FNV-1a hash of the binary md5, starting with the given seed
+  // NOTE: This must be kept in sync with 'md5_hash' in create_props.pl
+  const auto hash = [&md5](uInt32 seed) {
+    uInt32 h = seed == 0 ? 0x811c9dc5 : seed;
+    for(int i = 56; i >= 0; i -= 8)
+      h = (h ^ uInt8(md5.hi >> i)) * 0x01000193;
+    for(int i = 56; i >= 0; i -= 8)
+      h = (h ^ uInt8(md5.lo >> i)) * 0x01000193;
+    return h;
+  };
+
+  // The seed of the bucket either directly encodes the slot (as -slot-1),
+  // or is used to hash the md5 into its slot
+  const Int32 seed = DefPropsSeeds[hash(0) % DEF_PROPS_SIZE];
+  const uInt32 slot = seed < 0 ? uInt32(-seed - 1) : hash(seed) % DEF_PROPS_SIZE;
+
+  // Any md5 maps to some slot, so verify that it is the one stored there
+  if(DefProps[slot].md5Hi != md5.hi || DefProps[slot].md5Lo != md5.lo)
+    return -1;
+
+  return slot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PropertiesSet::loadDefProps(uInt32 slot, Properties& properties)
+{
+  properties.set(PropType::Cart_MD5,
+    MD5::toString(MD5::Digest{DefProps[slot].md5Hi, DefProps[slot].md5Lo}));
+
+  for(uInt32 f = DefProps[slot].firstField; f < DefProps[slot + 1].firstField; ++f)
+    properties.set(PropType(DefPropsFields[f].type),
+                   DefPropsStrings[DefPropsFields[f].value]);
+}
@@ -18,17 +18,18 @@
 #ifndef PROPERTIES_SET_HXX
 #define PROPERTIES_SET_HXX
 
-#include <map>
+#include <unordered_map>
 
 class FilesystemNode;
 class OSystem;
 
 #include "bspf.hxx"
+#include "MD5.hxx"
 #include "Props.hxx"
 
 /**
-  This class maintains an ordered collection of properties, maintained
-  in a C++ map and accessible by ROM md5.  The md5 is used since this is
+  This class maintains a collection of properties, maintained in a
+  C++ hash map and accessible by ROM md5.  The md5 is used since this is
   the attribute which must be present in each entry in stella.pro
   and least likely to change.  A change in MD5 would mean a change in
   the game rom image (essentially a different game) and this would
@@ -111,7 +112,19 @@ class PropertiesSet
     void print() const;
 
   private:
-    using PropsList = std::map<string, Properties>;
+    using PropsList = std::unordered_map<MD5::Digest, Properties, MD5::DigestHash>;
+
+    /**
+      Get the slot of the given md5 in the built-in properties database.
+
+      @return  The slot, or -1 if the md5 is not in the database
+    */
+    static Int32 defPropsSlot(const MD5::Digest& md5);
+
+    /**
+      Set the properties from the given slot of the built-in database.
+    */
+    static void loadDefProps(uInt32 slot, Properties& properties);
 
     // The properties read from an external 'stella.pro' file
     PropsList myExternalProps;
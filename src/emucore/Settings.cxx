@@ -88,6 +88,8 @@ Settings::Settings()
   setPermanent(AudioSettings::SETTING_BUFFER_SIZE, AudioSettings::DEFAULT_BUFFER_SIZE);
   setPermanent(AudioSettings::SETTING_STEREO, AudioSettings::DEFAULT_STEREO);
   setPermanent(AudioSettings::SETTING_DPC_PITCH, AudioSettings::DEFAULT_DPC_PITCH);
+  setPermanent(AudioSettings::SETTING_TELEMETRY, AudioSettings::DEFAULT_TELEMETRY);
+  setPermanent(AudioSettings::SETTING_DYNAMIC_RATE, AudioSettings::DEFAULT_DYNAMIC_RATE);
 
   // Input event options
   setPermanent("event_ver", "1");
@@ -163,9 +165,14 @@ Settings::Settings()
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
   setPermanent("threads", "false");
+  setPermanent("threadcount", "0");
+  setPermanent("decoupled", "false");
+  setPermanent("frametiming", "false");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
   setTemporary("turbo", "0");
+  setTemporary("framehash", "0");
+  setTemporary("startuptime", "false");
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger/disassembly options
@@ -255,7 +262,12 @@ void Settings::load(const Options& options)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::save()
 {
-  myRespository->save(myPermanentSettings);
+  Options permanent;
+  for(const auto& setting: mySettings)
+    if(setting.isPermanent)
+      permanent.emplace(setting.key, setting.value);
+
+  myRespository->save(permanent);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -284,6 +296,12 @@ void Settings::validate()
   i = getInt("tv.filter");
   if(i < 0 || i > 5)  setValue("tv.filter", "0");
 
+  i = getInt("threadcount");
+  if(i < 0 || i > 32)  setValue("threadcount", "0");
+
+  i = getInt("framehash");
+  if(i < 0)  setValue("framehash", "0");
+
   i = getInt("dev.tv.jitter_recovery");
   if(i < 1 || i > 20) setValue("dev.tv.jitter_recovery", "2");
 
@@ -434,6 +452,10 @@ void Settings::usage() const
     << "  -audio.buffer_size        <0-20>     Max. number of additional half-\n"
     << "                                        frames to buffer\n"
     << "  -audio.stereo             <1|0>      Enable stereo mode for all ROMs\n"
+    << "  -audio.dynamic_rate       <0-2000>   Max. resampling rate adjustment (ppm)\n"
+    << "                                        to keep the buffer level (0 = off)\n"
+    << "  -audio.telemetry          <1|0>      Collect audio pipeline statistics (shown\n"
+    << "                                        with frame stats, saved as CSV)\n"
     << endl
   #endif
     << "  -tia.zoom        <zoom>       Use the specified zoom level (windowed mode)\n"
@@ -488,6 +510,15 @@ void Settings::usage() const
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
+    << "  -threadcount  <0-32>         Number of threads used for multi-threaded\n"
+    << "                                rendering (0 = automatic)\n"
+    << "  -decoupled    <1|0>          Keep emulating while a frame is displayed,\n"
+    << "                                independent of rendering delays\n"
+    << "  -frametiming  <1|0>          Collect frame pacing statistics (shown with\n"
+    << "                                frame stats, saved as CSV)\n"
+    << "  -framehash    <number>       Print the hashes of every n-th frame and of\n"
+    << "                                the audio (0 = off)\n"
+    << "  -startuptime  <1|0>          Print how long the phases of the startup take\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
     << "  -snaploaddir  <path>         The directory to load snapshot files from\n"
     << "  -snapname     <int|rom>      Name snapshots according to internal database or\n"
@@ -665,40 +696,123 @@ void Settings::usage() const
 const Variant& Settings::value(const string& key) const
 {
   // Try to find the named setting and answer its value
-  auto it = myPermanentSettings.find(key);
-  if(it != myPermanentSettings.end())
-    return it->second;
-  else
-  {
-    it = myTemporarySettings.find(key);
-    if(it != myTemporarySettings.end())
-      return it->second;
-  }
-  return EmptyVariant;
+  auto it = myIndex.find(key);
+  return it != myIndex.end() ? mySettings[it->second].value : EmptyVariant;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Settings::getInt(const string& key) const
+{
+  auto it = myIndex.find(key);
+  return it != myIndex.end() ? mySettings[it->second].intValue : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+float Settings::getFloat(const string& key) const
+{
+  auto it = myIndex.find(key);
+  return it != myIndex.end() ? mySettings[it->second].floatValue : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Settings::getBool(const string& key) const
+{
+  auto it = myIndex.find(key);
+  return it != myIndex.end() ? mySettings[it->second].boolValue : false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::setValue(const string& key, const Variant& value, bool persist)
 {
-  auto it = myPermanentSettings.find(key);
-  if(it != myPermanentSettings.end()) {
-    if (persist && it->second != value) myRespository->save(key, value);
-    it->second = value;
-  }
-  else
-    myTemporarySettings[key] = value;
+  setValue(Handle(findOrAdd(key)), value, persist);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Settings::setValue(Handle handle, const Variant& value, bool persist)
+{
+  const Setting& setting = mySettings[handle.myIndex];
+  if(setting.value == value)
+    return;
+
+  if(persist && setting.isPermanent)
+    myRespository->save(setting.key, value);
+
+  assign(handle.myIndex, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Settings::Handle Settings::handle(const string& key) const
+{
+  return Handle(findOrAdd(key));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Settings::addObserver(Handle handle, const Observer& observer)
+{
+  ObserverEntry entry;
+  entry.id = ++myNextObserverId;
+  entry.index = handle.myIndex;
+  entry.observer = observer;
+  myObservers.push_back(entry);
+
+  return entry.id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Settings::removeObserver(uInt32 id)
+{
+  myObservers.erase(std::remove_if(myObservers.begin(), myObservers.end(),
+      [id](const ObserverEntry& entry) { return entry.id == id; }),
+    myObservers.end());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::setPermanent(const string& key, const Variant& value)
 {
-  myPermanentSettings[key] = value;
+  const uInt32 index = findOrAdd(key);
+
+  mySettings[index].isPermanent = true;
+  assign(index, value);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::setTemporary(const string& key, const Variant& value)
 {
-  myTemporarySettings[key] = value;
+  const uInt32 index = findOrAdd(key);
+
+  // A permanent setting keeps its value
+  if(!mySettings[index].isPermanent)
+    assign(index, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Settings::findOrAdd(const string& key) const
+{
+  auto it = myIndex.find(key);
+  if(it != myIndex.end())
+    return it->second;
+
+  const uInt32 index = uInt32(mySettings.size());
+  mySettings.emplace_back();
+  mySettings.back().key = key;
+  myIndex.emplace(key, index);
+
+  return index;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Settings::assign(uInt32 index, const Variant& value)
+{
+  Setting& setting = mySettings[index];
+
+  setting.value = value;
+  setting.intValue = value.toInt();
+  setting.floatValue = value.toFloat();
+  setting.boolValue = value.toBool();
+
+  for(const auto& entry: myObservers)
+    if(entry.index == index)
+      entry.observer(setting.value);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
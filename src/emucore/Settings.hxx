@@ -18,7 +18,10 @@
 #ifndef SETTINGS_HXX
 #define SETTINGS_HXX
 
+#include <deque>
+#include <functional>
 #include <map>
+#include <unordered_map>
 
 #include "Variant.hxx"
 #include "bspf.hxx"
@@ -38,6 +41,11 @@
   If an option isn't registered as permanent, it will be considered
   temporary and will not be saved.
 
+  Each value is parsed once when it is set, so that the convenience methods
+  return the native value without any conversion.  Code which accesses a
+  setting frequently can obtain a handle to it, avoiding the lookup of the
+  key, and can be notified of changes instead of querying the value again.
+
   @author  Stephen Anthony
 */
 class Settings
@@ -51,6 +59,23 @@ class Settings
 
     using Options = std::map<string, Variant>;
 
+    /**
+      A handle to a setting, obtained by 'handle'.  It stays valid for the
+      lifetime of the settings.
+    */
+    class Handle {
+      public:
+        Handle() = default;
+
+      private:
+        explicit Handle(uInt32 index) : myIndex(index) { }
+        uInt32 myIndex{0};
+
+      friend class Settings;
+    };
+
+    using Observer = std::function<void(const Variant& value)>;
+
     static constexpr int SETTINGS_VERSION = 1;
     static constexpr const char* SETTINGS_VERSION_KEY = "settings.version";
 
@@ -99,13 +124,44 @@ class Settings
       @param key  The key of the setting to lookup
       @return  The specific type value of the variant
     */
-    int getInt(const string& key) const     { return value(key).toInt();   }
-    float getFloat(const string& key) const { return value(key).toFloat(); }
-    bool getBool(const string& key) const   { return value(key).toBool();  }
+    int getInt(const string& key) const;
+    float getFloat(const string& key) const;
+    bool getBool(const string& key) const;
     const string& getString(const string& key) const { return value(key).toString(); }
     const Common::Size getSize(const string& key) const { return value(key).toSize(); }
     const Common::Point getPoint(const string& key) const { return value(key).toPoint(); }
 
+    /**
+      Get the handle of the specified key.  A key which hasn't been
+      registered yet is registered as an empty temporary setting.
+
+      @param key  The key of the setting
+      @return  The handle of the setting
+    */
+    Handle handle(const string& key) const;
+
+    /**
+      The same methods as above, accessing the setting by its handle.
+    */
+    const Variant& value(Handle handle) const { return setting(handle).value; }
+    void setValue(Handle handle, const Variant& value, bool persist = true);
+
+    int getInt(Handle handle) const     { return setting(handle).intValue;   }
+    float getFloat(Handle handle) const { return setting(handle).floatValue; }
+    bool getBool(Handle handle) const   { return setting(handle).boolValue;  }
+    const string& getString(Handle handle) const { return setting(handle).value.toString(); }
+
+    /**
+      Call the observer whenever the value of the setting changes.
+
+      @param handle    The handle of the setting
+      @param observer  The function to call with the new value
+      @return  An id, which must be passed to 'removeObserver' before the
+               observer becomes invalid
+    */
+    uInt32 addObserver(Handle handle, const Observer& observer);
+    void removeObserver(uInt32 id);
+
   protected:
     /**
       Add key/value pair to specified map.  Note that these should only be called
@@ -124,12 +180,6 @@ class Settings
               str.substr(first, str.find_last_not_of(' ')-first+1);
     }
 
-    // FIXME - Rework so that these aren't needed; hence no commenting added
-    const Options& getPermanentSettings() const
-      { return myPermanentSettings; }
-    const Options& getTemporarySettings() const
-      { return myTemporarySettings; }
-
   private:
     /**
       This method must be called *after* settings have been fully loaded
@@ -147,14 +197,51 @@ class Settings
      */
     void migrate();
 
+    struct Setting {
+      string key;
+      Variant value;
+
+      // The value converted to the native types
+      Int32 intValue{0};
+      float floatValue{0};
+      bool boolValue{false};
+
+      // Permanent settings are saved on each program exit, temporary
+      // settings are never saved
+      bool isPermanent{false};
+    };
+
+    const Setting& setting(Handle handle) const {
+      return mySettings[handle.myIndex];
+    }
+
+    /**
+      Find the setting with the specified key, registering it (as an empty
+      temporary setting) if necessary.
+
+      @return  The index of the setting
+    */
+    uInt32 findOrAdd(const string& key) const;
+
+    /**
+      Assign a new value to the setting, and notify its observers.
+    */
+    void assign(uInt32 index, const Variant& value);
+
   private:
-    // Holds key/value pairs that are necessary for Stella to
-    // function and must be saved on each program exit.
-    Options myPermanentSettings;
+    // All registered settings, in the order of their registration; the
+    // handle of a setting is its index (a deque never moves its elements,
+    // so references to the values stay valid)
+    mutable std::deque<Setting> mySettings;
+    mutable std::unordered_map<string, uInt32> myIndex;
 
-    // Holds auxiliary key/value pairs that shouldn't be saved on
-    // program exit.
-    Options myTemporarySettings;
+    struct ObserverEntry {
+      uInt32 id{0};
+      uInt32 index{0};
+      Observer observer;
+    };
+    vector<ObserverEntry> myObservers;
+    uInt32 myNextObserverId{0};
 
     shared_ptr<KeyValueRepository> myRespository;
 
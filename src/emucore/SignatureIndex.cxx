@@ -0,0 +1,82 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "SignatureIndex.hxx"
+
+namespace {
+  inline uInt32 pair(const uInt8* bytes)
+  {
+    return (uInt32(bytes[0]) << 8) | bytes[1];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SignatureIndex::SignatureIndex(const uInt8* image, size_t size)
+  : myImage(image),
+    mySize(size),
+    myPairStart(0x10000 + 1, 0)
+{
+  if(size < 2) return;
+
+  const size_t pairs = size - 1;
+
+  // Counting sort of the offsets by the value of the byte pair starting there
+  for(size_t i = 0; i < pairs; ++i)
+    ++myPairStart[pair(image + i) + 1];
+  for(uInt32 p = 0; p < 0x10000; ++p)
+    myPairStart[p + 1] += myPairStart[p];
+
+  vector<uInt32> next(myPairStart.begin(), myPairStart.end() - 1);
+  myOffsets.resize(pairs);
+  for(size_t i = 0; i < pairs; ++i)
+    myOffsets[next[pair(image + i)]++] = uInt32(i);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SignatureIndex::search(const uInt8* signature, uInt32 sigsize,
+                            uInt32 minhits, size_t limit) const
+{
+  if(minhits == 0)
+    return true;
+
+  limit = std::min(limit, mySize);
+  if(sigsize < 2 || limit <= sigsize)
+    return false;
+
+  const uInt32 p = pair(signature);
+  uInt32 count = 0;
+  size_t skip = 0;
+
+  for(uInt32 i = myPairStart[p]; i < myPairStart[p + 1]; ++i)
+  {
+    const size_t offset = myOffsets[i];
+
+    if(offset >= limit - sigsize)
+      break;
+    if(offset < skip)
+      continue;
+
+    if(std::equal(signature + 2, signature + sigsize, myImage + offset + 2))
+    {
+      if(++count == minhits)
+        return true;
+      skip = offset + sigsize + 1;  // skip past this signature 'window' entirely
+    }
+  }
+
+  return false;
+}
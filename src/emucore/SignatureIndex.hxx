@@ -0,0 +1,83 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SIGNATURE_INDEX_HXX
+#define SIGNATURE_INDEX_HXX
+
+#include "bspf.hxx"
+
+/**
+  An index of a ROM image for the cartridge and controller autodetection,
+  which search the image for dozens of byte signatures.
+
+  The image is scanned once, sorting the offsets of all byte pairs by their
+  value. A signature search then only has to compare the offsets starting
+  with the first two bytes of the signature, instead of the whole image.
+
+  The image is not copied and must outlive the index.
+*/
+class SignatureIndex
+{
+  public:
+    /**
+      Create the index of a ROM image.
+
+      @param image  A pointer to the ROM image
+      @param size   The size of the ROM image
+    */
+    SignatureIndex(const uInt8* image, size_t size);
+
+    const uInt8* data() const { return myImage; }
+    size_t size() const { return mySize; }
+    uInt8 operator[](size_t i) const { return myImage[i]; }
+
+    /**
+      Search the start of the image for the specified byte signature.
+      Like the former linear search, the last byte of the searched area is
+      never matched, and a hit skips the signature and the following byte.
+
+      @param signature  The byte sequence to search for
+      @param sigsize    The number of bytes in the signature (at least 2)
+      @param minhits    The minimum number of times a signature is to be found
+      @param limit      The number of bytes to search from the image start
+
+      @return  True if the signature was found at least 'minhits' time, else false
+    */
+    bool search(const uInt8* signature, uInt32 sigsize, uInt32 minhits,
+                size_t limit) const;
+
+  private:
+    const uInt8* myImage{nullptr};
+    size_t mySize{0};
+
+    // Offsets of all byte pairs, ordered by pair value, and ascending within
+    // each pair value
+    vector<uInt32> myOffsets;
+
+    // Start of each pair value in myOffsets (plus an end marker)
+    vector<uInt32> myPairStart;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SignatureIndex() = delete;
+    SignatureIndex(const SignatureIndex&) = delete;
+    SignatureIndex(SignatureIndex&&) = delete;
+    SignatureIndex& operator=(const SignatureIndex&) = delete;
+    SignatureIndex& operator=(SignatureIndex&&) = delete;
+};
+
+#endif
@@ -58,6 +58,8 @@ TIASurface::TIASurface(OSystem& system)
     TIAConstants::frameBufferHeight,
     interpolationModeFromSettings(myOSystem.settings())
   );
+  // Only the scanlines which changed are converted and uploaded
+  myTiaSurface->setDirtyTracking(true);
 
   // Generate scanline data, and a pre-defined scanline surface
   constexpr uInt32 scanHeight = TIAConstants::frameBufferHeight * 2;
@@ -73,10 +75,9 @@ TIASurface::TIASurface(OSystem& system)
   myBaseTiaSurface = myFB.allocateSurface(TIAConstants::frameBufferWidth*2,
                                           TIAConstants::frameBufferHeight);
 
-  myRGBFramebuffer.fill(0);
-
   // Enable/disable threading in the NTSC TV effects renderer
-  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"));
+  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"),
+                               myOSystem.settings().getInt("threadcount"));
 
   myPaletteHandler = make_unique<PaletteHandler>(myOSystem);
   myPaletteHandler->loadConfig(myOSystem.settings());
@@ -99,6 +100,7 @@ void TIASurface::initialize(const Console& console,
   mySLineSurface->setDstSize(mode.image.w(), mode.image.h());
 
   myPaletteHandler->setPalette();
+  myPendingLines.set();
 
   // Phosphor mode can be enabled either globally or per-ROM
   int p_blend = 0;
@@ -136,6 +138,7 @@ void TIASurface::setPalette(const PaletteArray& tia_palette,
                             const PaletteArray& rgb_palette)
 {
   myPalette = tia_palette;
+  myPendingLines.set();
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -279,7 +282,8 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   if(myPhosphorHandler.initialize(enable, blend))
   {
     myFilter = Filter(enable ? uInt8(myFilter) | 0x01 : uInt8(myFilter) & 0x10);
-    myRGBFramebuffer.fill(0);
+    resetRGBFramebuffer();
+    myPendingLines.set();
   }
 }
 
@@ -287,6 +291,7 @@ void TIASurface::enablePhosphor(bool enable, int blend)
 void TIASurface::enableNTSC(bool enable)
 {
   myFilter = Filter(enable ? uInt8(myFilter) | 0x10 : uInt8(myFilter) & 0x01);
+  myPendingLines.set();
 
   uInt32 surfaceWidth = enable ?
     AtariNTSC::outWidth(TIAConstants::frameBufferWidth) : TIAConstants::frameBufferWidth;
@@ -305,7 +310,26 @@ void TIASurface::enableNTSC(bool enable)
   sl_attr.blendalpha = myOSystem.settings().getInt("tv.scanlines");
   mySLineSurface->applyAttributes();
 
-  myRGBFramebuffer.fill(0);
+  resetRGBFramebuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::resetRGBFramebuffer()
+{
+  if(myPhosphorHandler.phosphorEnabled())
+  {
+    // With the NTSC filter, the phosphor buffer holds the filtered output
+    const uInt32 width = uInt8(myFilter) & 0x10
+      ? AtariNTSC::outWidth(TIAConstants::frameBufferWidth)
+      : TIAConstants::frameBufferWidth;
+
+    myRGBFramebuffer.assign(width * TIAConstants::frameBufferHeight, 0);
+  }
+  else
+  {
+    myRGBFramebuffer.clear();
+    myRGBFramebuffer.shrink_to_fit();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -367,22 +391,28 @@ void TIASurface::render()
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
 
+  // Only convert the scanlines which changed since the last render
+  const std::bitset<TIAConstants::frameBufferHeight> lines =
+    myTIA->takeDirtyLines() | myPendingLines;
+  myPendingLines.reset();
+
   switch(myFilter)
   {
     case Filter::Normal:
     {
       uInt8* tiaIn = myTIA->frameBuffer();
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
       for(uInt32 y = 0; y < height; ++y)
       {
-        pos = screenofsY;
+        if(!lines[y]) continue;
+
+        uInt32 bufofs = y * width, pos = y * outPitch;
         for (uInt32 x = width / 2; x; --x)
         {
           out[pos++] = myPalette[tiaIn[bufofs++]];
           out[pos++] = myPalette[tiaIn[bufofs++]];
         }
-        screenofsY += outPitch;
+        myTiaSurface->markDirtyRows(y, 1);
       }
       break;
     }
@@ -393,22 +423,28 @@ void TIASurface::render()
       uInt32* rgbIn = myRGBFramebuffer.data();
 
       if (mySaveSnapFlag)
-        std::copy_n(myRGBFramebuffer.begin(), width * height,
-                    myPrevRGBFramebuffer.begin());
+        myPrevRGBFramebuffer.assign(myRGBFramebuffer.begin(),
+                                    myRGBFramebuffer.begin() + width * height);
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = height; y ; --y)
+      for(uInt32 y = 0; y < height; ++y)
       {
-        pos = screenofsY;
+        // Unchanged scanlines can only be skipped once they stopped decaying
+        if(!lines[y]) continue;
+
+        uInt32 bufofs = y * width, pos = y * outPitch;
+        uInt32* outRow = out + pos;
+
+        // Expand the palette into the output row first
         for(uInt32 x = width / 2; x ; --x)
         {
-          // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = PhosphorHandler::getPixel(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
-          rgbIn[bufofs] = out[pos++] = PhosphorHandler::getPixel(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
+          out[pos++] = myPalette[tiaIn[bufofs++]];
+          out[pos++] = myPalette[tiaIn[bufofs++]];
         }
-        screenofsY += outPitch;
+        // Blend with the previous frame, and store back into displayed
+        // frame buffer (for next frame)
+        if(PhosphorHandler::blendRow(outRow, rgbIn + y * width, outRow, width))
+          myPendingLines.set(y);
+        myTiaSurface->markDirtyRows(y, 1);
       }
       break;
     }
@@ -416,16 +452,18 @@ void TIASurface::render()
     case Filter::BlarggNormal:
     {
       myNTSCFilter.render(myTIA->frameBuffer(), width, height, out, outPitch << 2);
+      myTiaSurface->markDirtyRows(0, height);
       break;
     }
 
     case Filter::BlarggPhosphor:
     {
       if(mySaveSnapFlag)
-        std::copy_n(myRGBFramebuffer.begin(), height * outPitch,
-                    myPrevRGBFramebuffer.begin());
+        myPrevRGBFramebuffer.assign(myRGBFramebuffer.begin(),
+                                    myRGBFramebuffer.begin() + height * outPitch);
 
       myNTSCFilter.render(myTIA->frameBuffer(), width, height, out, outPitch << 2, myRGBFramebuffer.data());
+      myTiaSurface->markDirtyRows(0, height);
       break;
     }
   }
@@ -462,6 +500,11 @@ void TIASurface::renderForSnapshot()
 
   myTiaSurface->basePtr(outPtr, outPitch);
 
+  // Unless the snapshot was requested before rendering, there is no previous
+  // frame; use the current one instead
+  if(myPhosphorHandler.phosphorEnabled() && myPrevRGBFramebuffer.empty())
+    myPrevRGBFramebuffer = myRGBFramebuffer;
+
   mySaveSnapFlag = false;
   switch (myFilter)
   {
@@ -498,12 +541,20 @@ void TIASurface::renderForSnapshot()
 
   if(myPhosphorHandler.phosphorEnabled())
   {
+    // The averaged frame replaced the surface contents; restore them on
+    // the next render
+    myTiaSurface->markDirtyRows(0, height);
+    myPendingLines.set();
+
     // Draw TIA image
     myTiaSurface->render();
 
     // Draw overlaying scanlines
     if(myScanlinesEnabled)
       mySLineSurface->render();
+
+    myPrevRGBFramebuffer.clear();
+    myPrevRGBFramebuffer.shrink_to_fit();
   }
 }
 
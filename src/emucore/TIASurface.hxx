@@ -24,6 +24,7 @@ class OSystem;
 class FBSurface;
 class PaletteHandler;
 
+#include <bitset>
 #include <thread>
 
 #include "Rect.hxx"
@@ -183,6 +184,12 @@ class TIASurface
     */
     uInt32 averageBuffers(uInt32 bufOfs);
 
+    /**
+      Clear the phosphor buffer, and size it for the current filter (it is
+      only allocated while phosphor mode is enabled).
+    */
+    void resetRGBFramebuffer();
+
   private:
     OSystem& myOSystem;
     FrameBuffer& myFB;
@@ -208,12 +215,16 @@ class TIASurface
     // RGB frame buffer
     PhosphorHandler myPhosphorHandler;
 
-    std::array<uInt32, AtariNTSC::outWidth(TIAConstants::frameBufferWidth) *
-        TIAConstants::frameBufferHeight> myRGBFramebuffer;
-    std::array<uInt32, AtariNTSC::outWidth(TIAConstants::frameBufferWidth) *
-        TIAConstants::frameBufferHeight> myPrevRGBFramebuffer;
+    vector<uInt32> myRGBFramebuffer;
+    // The previous frame, only kept while a snapshot is taken
+    vector<uInt32> myPrevRGBFramebuffer;
     /////////////////////////////////////////////////////////////
 
+    // Scanlines which must be converted on the next render, even if the TIA
+    // didn't change them (after mode or palette changes, or while the
+    // phosphor effect is still decaying them)
+    std::bitset<TIAConstants::frameBufferHeight> myPendingLines;
+
     // Use scanlines in TIA rendering mode
     bool myScanlinesEnabled{false};
 
@@ -0,0 +1,142 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cstring>
+
+#include "XXH64.hxx"
+
+namespace {
+  constexpr uInt64 PRIME1 = 0x9E3779B185EBCA87ULL;
+  constexpr uInt64 PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr uInt64 PRIME3 = 0x165667B19E3779F9ULL;
+  constexpr uInt64 PRIME4 = 0x85EBCA77C2B2AE63ULL;
+  constexpr uInt64 PRIME5 = 0x27D4EB2F165667C5ULL;
+
+  inline uInt64 rotl(uInt64 x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  // The message is read as little-endian words, so that the hashes are
+  // identical on all platforms
+  inline uInt64 read64(const uInt8* p)
+  {
+    uInt64 v;
+    std::memcpy(&v, p, sizeof(v));
+  #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+  #endif
+    return v;
+  }
+
+  inline uInt32 read32(const uInt8* p)
+  {
+    uInt32 v;
+    std::memcpy(&v, p, sizeof(v));
+  #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap32(v);
+  #endif
+    return v;
+  }
+
+  inline uInt64 mix(uInt64 acc, uInt64 input)
+  {
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+  }
+
+  inline uInt64 merge(uInt64 acc, uInt64 val)
+  {
+    acc ^= mix(0, val);
+    return acc * PRIME1 + PRIME4;
+  }
+}
+
+namespace XXH64 {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 hash(const uInt8* buffer, size_t length, uInt64 seed)
+{
+  const uInt8* p = buffer;
+  const uInt8* const end = buffer + length;
+  uInt64 h;
+
+  if(length >= 32)
+  {
+    const uInt8* const limit = end - 32;
+    uInt64 v1 = seed + PRIME1 + PRIME2;
+    uInt64 v2 = seed + PRIME2;
+    uInt64 v3 = seed;
+    uInt64 v4 = seed - PRIME1;
+
+    do {
+      v1 = mix(v1, read64(p));
+      v2 = mix(v2, read64(p + 8));
+      v3 = mix(v3, read64(p + 16));
+      v4 = mix(v4, read64(p + 24));
+      p += 32;
+    } while(p <= limit);
+
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = merge(h, v1);
+    h = merge(h, v2);
+    h = merge(h, v3);
+    h = merge(h, v4);
+  }
+  else
+    h = seed + PRIME5;
+
+  h += uInt64(length);
+
+  for(; p + 8 <= end; p += 8)
+  {
+    h ^= mix(0, read64(p));
+    h = rotl(h, 27) * PRIME1 + PRIME4;
+  }
+  if(p + 4 <= end)
+  {
+    h ^= uInt64(read32(p)) * PRIME1;
+    h = rotl(h, 23) * PRIME2 + PRIME3;
+    p += 4;
+  }
+  for(; p < end; ++p)
+  {
+    h ^= uInt64(*p) * PRIME5;
+    h = rotl(h, 11) * PRIME1;
+  }
+
+  // Avalanche
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+
+  return h;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string toString(uInt64 hash)
+{
+  std::ostringstream buf;
+  buf << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+  return buf.str();
+}
+
+}  // Namespace XXH64
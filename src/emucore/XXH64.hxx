@@ -0,0 +1,51 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef XXH64_HXX
+#define XXH64_HXX
+
+#include "bspf.hxx"
+
+/**
+  An implementation of the XXH64 hash function (by Yann Collet).  This is a
+  fast, non-cryptographic 64-bit hash, used to identify frames and audio
+  fragments in regression tests and movie verification.  The message is
+  processed in four independent lanes, so the CPU can work on all of them in
+  parallel.
+
+  Hashes can be chained by using the previous hash as seed for the next one.
+*/
+namespace XXH64 {
+
+/**
+  Get the XXH64 hash of the specified message with the given length.
+
+  @param buffer The message to hash
+  @param length The length of the message (in bytes)
+  @param seed   The seed (or the previous hash, when chaining)
+  @return The hash value
+*/
+uInt64 hash(const uInt8* buffer, size_t length, uInt64 seed = 0);
+
+/**
+  Format a hash value as 16 hexadecimal digits.
+*/
+string toString(uInt64 hash);
+
+}  // Namespace XXH64
+
+#endif
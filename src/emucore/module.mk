@@ -74,6 +74,7 @@ MODULE_OBJS := \
 	src/emucore/M6532.o \
 	src/emucore/MT24LC256.o \
 	src/emucore/MD5.o \
+	src/emucore/MusicOscillator.o \
 	src/emucore/OSystem.o \
 	src/emucore/Paddles.o \
 	src/emucore/PointingDevice.o \
@@ -83,10 +84,12 @@ MODULE_OBJS := \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/SignatureIndex.o \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASurface.o \
-	src/emucore/Thumbulator.o
+	src/emucore/Thumbulator.o \
+	src/emucore/XXH64.o
 
 MODULE_DIRS += \
 	src/emucore
@@ -17,6 +17,7 @@
 
 #include "Audio.hxx"
 #include "AudioQueue.hxx"
+#include "XXH64.hxx"
 
 #include <cmath>
 
@@ -46,6 +47,7 @@ void Audio::reset()
 {
   myCounter = 0;
   mySampleIndex = 0;
+  myHash = 0;
 
   myChannel0.reset();
   myChannel1.reset();
@@ -58,6 +60,14 @@ void Audio::setAudioQueue(const shared_ptr<AudioQueue>& queue)
 
   myCurrentFragment = myAudioQueue->enqueue();
   mySampleIndex = 0;
+
+  myExternalSamples = make_unique<Int16[]>(myAudioQueue->fragmentSize());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::setExternalSource(const ExternalSource& source)
+{
+  myExternalSource = source;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -96,11 +106,41 @@ void Audio::phase1()
   }
 
   if (++mySampleIndex == myAudioQueue->fragmentSize()) {
+    if (myExternalSource) mixExternalSource();
+
+    if (myHashingEnabled)
+      myHash = XXH64::hash(reinterpret_cast<const uInt8*>(myCurrentFragment),
+        (myAudioQueue->isStereo() ? 2 : 1) * mySampleIndex * sizeof(Int16), myHash);
+
     mySampleIndex = 0;
     myCurrentFragment = myAudioQueue->enqueue(myCurrentFragment);
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::mixExternalSource()
+{
+  const uInt32 fragmentSize = myAudioQueue->fragmentSize();
+  const bool isStereo = myAudioQueue->isStereo();
+
+  // The external samples are generated for the whole fragment at once
+  myExternalSource(myExternalSamples.get(), fragmentSize);
+
+  for (uInt32 i = 0; i < fragmentSize; ++i) {
+    const Int32 external = myExternalSamples[i];
+
+    if (isStereo) {
+      myCurrentFragment[2*i] = static_cast<Int16>(
+        BSPF::clamp(myCurrentFragment[2*i] + external, -0x8000, 0x7fff));
+      myCurrentFragment[2*i + 1] = static_cast<Int16>(
+        BSPF::clamp(myCurrentFragment[2*i + 1] + external, -0x8000, 0x7fff));
+    } else {
+      myCurrentFragment[i] = static_cast<Int16>(
+        BSPF::clamp(myCurrentFragment[i] + external, -0x8000, 0x7fff));
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioChannel& Audio::channel0()
 {
@@ -26,6 +26,14 @@ class AudioQueue;
 
 class Audio : public Serializable
 {
+  public:
+    /**
+      An additional audio source (e.g. the KidVid tape) that is mixed into
+      the TIA output.  It fills the buffer with the given number of signed
+      mono samples at the TIA sample rate.
+    */
+    using ExternalSource = std::function<void(Int16* samples, uInt32 count)>;
+
   public:
     Audio();
 
@@ -33,6 +41,16 @@ class Audio : public Serializable
 
     void setAudioQueue(const shared_ptr<AudioQueue>& queue);
 
+    void setExternalSource(const ExternalSource& source);
+
+    /**
+      Enable / disable hashing of the completed fragments.  The hash is
+      chained over all fragments since the last reset.
+    */
+    void enableHashing(bool enable) { myHashingEnabled = enable; }
+
+    uInt64 hash() const { return myHash; }
+
     void tick();
 
     AudioChannel& channel0();
@@ -48,6 +66,8 @@ class Audio : public Serializable
   private:
     void phase1();
 
+    void mixExternalSource();
+
   private:
     shared_ptr<AudioQueue> myAudioQueue;
 
@@ -62,6 +82,12 @@ class Audio : public Serializable
     Int16* myCurrentFragment{nullptr};
     uInt32 mySampleIndex{0};
 
+    ExternalSource myExternalSource{nullptr};
+    unique_ptr<Int16[]> myExternalSamples;
+
+    bool myHashingEnabled{false};
+    uInt64 myHash{0};
+
   private:
     Audio(const Audio&) = delete;
     Audio(Audio&&) = delete;
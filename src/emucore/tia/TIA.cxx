@@ -23,6 +23,7 @@
 #include "TIAConstants.hxx"
 #include "frame-manager/FrameManager.hxx"
 #include "AudioQueue.hxx"
+#include "XXH64.hxx"
 #include "DispatchResult.hxx"
 #include "Base.hxx"
 
@@ -62,6 +63,53 @@ enum ResxCounter: uInt8 {
 // 70, the G.I. Joe will show an artifact (hole in roof).
 static constexpr uInt8 resxLateHblankThreshold = TIAConstants::H_CYCLES - 3;
 
+static constexpr uInt32 FRAME_SIZE = TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight;
+
+// The display is stored run-length encoded (pairs of run length - 1 and color
+// index) in rewind states. TIA frames mostly consist of long runs, so this is
+// a fraction of the size of the raw buffers.
+static void putRunLengthEncoded(Serializer& out, const uInt8* data, size_t size)
+{
+  vector<uInt8> encoded;
+  encoded.reserve(size / 8);
+
+  for(size_t i = 0; i < size; )
+  {
+    const uInt8 color = data[i];
+    size_t run = 1;
+    while(run < 256 && i + run < size && data[i + run] == color) ++run;
+
+    encoded.push_back(static_cast<uInt8>(run - 1));
+    encoded.push_back(color);
+    i += run;
+  }
+
+  out.putInt(static_cast<uInt32>(encoded.size()));
+  out.putByteArray(encoded.data(), encoded.size());
+}
+
+static void getRunLengthEncoded(Serializer& in, uInt8* data, size_t size)
+{
+  // At worst, each pixel is a run of its own
+  const uInt32 length = in.getInt();
+  if(length > 2 * size)
+    throw runtime_error("invalid display data");
+
+  vector<uInt8> encoded(length);
+  in.getByteArray(encoded.data(), encoded.size());
+
+  size_t pos = 0;
+  for(size_t i = 0; i + 1 < encoded.size() && pos < size; i += 2)
+  {
+    const size_t run = std::min<size_t>(encoded[i] + 1, size - pos);
+    std::fill_n(data + pos, run, encoded[i + 1]);
+    pos += run;
+  }
+
+  if(pos != size)
+    throw runtime_error("invalid display data");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIA::TIA(ConsoleIO& console, const ConsoleTimingProvider& timingProvider,
          Settings& settings)
@@ -83,6 +131,23 @@ TIA::TIA(ConsoleIO& console, const ConsoleTimingProvider& timingProvider,
   myMissile1.setTIA(this);
   myBall.setTIA(this);
 
+  myHandles.devSettings  = mySettings.handle("dev.settings");
+  myHandles.tiaType      = mySettings.handle("dev.tia.type");
+  myHandles.plInvPhase   = mySettings.handle("dev.tia.plinvphase");
+  myHandles.msInvPhase   = mySettings.handle("dev.tia.msinvphase");
+  myHandles.blInvPhase   = mySettings.handle("dev.tia.blinvphase");
+  myHandles.pfBitsDelay  = mySettings.handle("dev.tia.delaypfbits");
+  myHandles.pfColorDelay = mySettings.handle("dev.tia.delaypfcolor");
+  myHandles.plSwapDelay  = mySettings.handle("dev.tia.delayplswap");
+  myHandles.blSwapDelay  = mySettings.handle("dev.tia.delayblswap");
+  myHandles.tiaDriven    = mySettings.handle("dev.tiadriven");
+  myHandles.jitter = {
+    mySettings.handle("plr.tv.jitter"), mySettings.handle("dev.tv.jitter") };
+  myHandles.jitterRecovery = {
+    mySettings.handle("plr.tv.jitter_recovery"), mySettings.handle("dev.tv.jitter_recovery") };
+  myHandles.colorLoss = {
+    mySettings.handle("plr.colorloss"), mySettings.handle("dev.colorloss") };
+
   initialize();
 }
 
@@ -171,10 +236,15 @@ void TIA::initialize()
 
   myFramesSinceLastRender = 0;
 
+  myFrameHash = myVideoHash = 0;
+
   // Blank the various framebuffers; they may contain graphical garbage
-  myBackBuffer.fill(0);
-  myFrontBuffer.fill(0);
+  for(Frame& frame: myFrames)
+    frame.fill(0);
   myFramebuffer.fill(0);
+  myDirtyLines.set();
+  myLastFrameKept = true;
+  myLinePixelsDrawn = 0;
 
   applyDeveloperSettings();
 
@@ -407,6 +477,20 @@ void TIA::bindToControllers()
 
   for (uInt8 i = 0; i < 4; ++i)
     updatePaddle(i);
+
+  // Mix the audio of controllers with their own audio source (KidVid)
+  Controller* audioController =
+    myConsole.rightController().hasAudio() ? &myConsole.rightController() :
+    myConsole.leftController().hasAudio() ? &myConsole.leftController() : nullptr;
+
+  if (audioController)
+    myAudio.setExternalSource(
+      [audioController] (Int16* samples, uInt32 count) {
+        audioController->generateAudio(samples, count);
+      }
+    );
+  else
+    myAudio.setExternalSource(nullptr);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -511,9 +595,23 @@ bool TIA::poke(uInt16 address, uInt8 value)
       break;
 
     case VSYNC:
+    {
+      const bool wasRendering = myFrameManager->isRendering();
+
       myFrameManager->setVsync(value & 0x02);
       myShadowRegisters[address] = value;
+
+      if (wasRendering && !myFrameManager->isRendering()) {
+        // Rendering stopped mid-line: the current line is drawn up to the beam,
+        // unless it is cached (it would have been cloned on the next line)
+        const Int32 x = myLinesSinceChange >= 2 || myHstate == HState::blank
+          ? 0 : myHctr - myHctrDelta - TIAConstants::H_BLANK_CLOCKS;
+
+        keepLastFrame(myFrameManager->getY() * TIAConstants::H_PIXEL +
+          std::max(uInt32(std::max(x, 0)), myLinePixelsDrawn));
+      }
       break;
+    }
 
     case VBLANK:
       myInput0.vblank(value);
@@ -863,10 +961,20 @@ bool TIA::saveDisplay(Serializer& out) const
 {
   try
   {
-    out.putByteArray(myFramebuffer.data(), myFramebuffer.size());
-    out.putByteArray(myBackBuffer.data(), myBackBuffer.size());
-    out.putByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    putRunLengthEncoded(out, myFramebuffer.data(), myFramebuffer.size());
+    putRunLengthEncoded(out, myBackBuffer, FRAME_SIZE);
+
+    // Unless a frame was completed since the last render, the front buffer
+    // is identical to the framebuffer
+    const bool frontIsRendered =
+      memcmp(myFrontBuffer, myFramebuffer.data(), FRAME_SIZE) == 0;
+    out.putBool(frontIsRendered);
+    if(!frontIsRendered)
+      putRunLengthEncoded(out, myFrontBuffer, FRAME_SIZE);
+
     out.putInt(myFramesSinceLastRender);
+    out.putBool(myLastFrameKept);
+    out.putInt(myLinePixelsDrawn);
   }
   catch(...)
   {
@@ -883,10 +991,16 @@ bool TIA::loadDisplay(Serializer& in)
   try
   {
     // Reset frame buffer pointer and data
-    in.getByteArray(myFramebuffer.data(), myFramebuffer.size());
-    in.getByteArray(myBackBuffer.data(), myBackBuffer.size());
-    in.getByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    getRunLengthEncoded(in, myFramebuffer.data(), myFramebuffer.size());
+    getRunLengthEncoded(in, myBackBuffer, FRAME_SIZE);
+    if(in.getBool())
+      std::copy_n(myFramebuffer.begin(), FRAME_SIZE, myFrontBuffer);
+    else
+      getRunLengthEncoded(in, myFrontBuffer, FRAME_SIZE);
     myFramesSinceLastRender = in.getInt();
+    myLastFrameKept = in.getBool();
+    myLinePixelsDrawn = in.getInt();
+    myDirtyLines.set();
   }
   catch(...)
   {
@@ -900,28 +1014,31 @@ bool TIA::loadDisplay(Serializer& in)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyDeveloperSettings()
 {
-  bool devSettings = mySettings.getBool("dev.settings");
+  const SettingsHandles& h = myHandles;
+
+  bool devSettings = mySettings.getBool(h.devSettings);
   if(devSettings)
   {
-    bool custom = BSPF::equalsIgnoreCase("custom", mySettings.getString("dev.tia.type"));
+    const string& type = mySettings.getString(h.tiaType);
+    bool custom = BSPF::equalsIgnoreCase("custom", type);
 
     setPlInvertedPhaseClock(custom
-                            ? mySettings.getBool("dev.tia.plinvphase")
-                            : BSPF::equalsIgnoreCase("koolaidman", mySettings.getString("dev.tia.type")));
+                            ? mySettings.getBool(h.plInvPhase)
+                            : BSPF::equalsIgnoreCase("koolaidman", type));
     setMsInvertedPhaseClock(custom
-                            ? mySettings.getBool("dev.tia.msinvphase")
-                            : BSPF::equalsIgnoreCase("cosmicark", mySettings.getString("dev.tia.type")));
-    setBlInvertedPhaseClock(custom ? mySettings.getBool("dev.tia.blinvphase") : false);
+                            ? mySettings.getBool(h.msInvPhase)
+                            : BSPF::equalsIgnoreCase("cosmicark", type));
+    setBlInvertedPhaseClock(custom ? mySettings.getBool(h.blInvPhase) : false);
     setPFBitsDelay(custom
-                   ? mySettings.getBool("dev.tia.delaypfbits")
-                   : BSPF::equalsIgnoreCase("pesco", mySettings.getString("dev.tia.type")));
+                   ? mySettings.getBool(h.pfBitsDelay)
+                   : BSPF::equalsIgnoreCase("pesco", type));
     setPFColorDelay(custom
-                    ? mySettings.getBool("dev.tia.delaypfcolor")
-                    : BSPF::equalsIgnoreCase("quickstep", mySettings.getString("dev.tia.type")));
+                    ? mySettings.getBool(h.pfColorDelay)
+                    : BSPF::equalsIgnoreCase("quickstep", type));
     setPlSwapDelay(custom
-                   ? mySettings.getBool("dev.tia.delayplswap")
-                   : BSPF::equalsIgnoreCase("heman", mySettings.getString("dev.tia.type")));
-    setBlSwapDelay(custom ? mySettings.getBool("dev.tia.delayblswap") : false);
+                   ? mySettings.getBool(h.plSwapDelay)
+                   : BSPF::equalsIgnoreCase("heman", type));
+    setBlSwapDelay(custom ? mySettings.getBool(h.blSwapDelay) : false);
   }
   else
   {
@@ -934,13 +1051,13 @@ void TIA::applyDeveloperSettings()
     setBlSwapDelay(false);
   }
 
-  myTIAPinsDriven = devSettings ? mySettings.getBool("dev.tiadriven") : false;
+  myTIAPinsDriven = devSettings ? mySettings.getBool(h.tiaDriven) : false;
 
-  myEnableJitter = mySettings.getBool(devSettings ? "dev.tv.jitter" : "plr.tv.jitter");
-  myJitterFactor = mySettings.getInt(devSettings ? "dev.tv.jitter_recovery" : "plr.tv.jitter_recovery");
+  myEnableJitter = mySettings.getBool(h.jitter[devSettings]);
+  myJitterFactor = mySettings.getInt(h.jitterRecovery[devSettings]);
 
   if(myFrameManager)
-    enableColorLoss(mySettings.getBool(devSettings ? "dev.colorloss" : "plr.colorloss"));
+    enableColorLoss(mySettings.getBool(h.colorLoss[devSettings]));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -958,16 +1075,57 @@ void TIA::renderToFrameBuffer()
 
   myFramesSinceLastRender = 0;
 
-  myFramebuffer = myFrontBuffer;
+  copyToFrameBuffer(myFrontBuffer, myFrontBufferScanlines);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::enableFramePublishing(bool enable)
+{
+  myFramePublishing = enable;
+
+  if (!enable)
+    myPublishedFrames.reset();
+  else if (!myPublishedFrames)
+    myPublishedFrames = make_unique<TripleBuffer<PublishedFrame>>();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::renderPublishedFrame()
+{
+  if (!myPublishedFrames || !myPublishedFrames->consume()) return 0;
+
+  const PublishedFrame& frame = myPublishedFrames->front();
+  copyToFrameBuffer(frame.pixels.data(), frame.scanlines);
+
+  return std::max(myFramesSincePublishedRender.exchange(0), 1U);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::copyToFrameBuffer(const uInt8* frame, uInt32 scanlines)
+{
+  // Most scanlines usually don't change between frames, so only copy
+  // (and mark dirty) the ones that did
+  for(uInt32 y = 0; y < TIAConstants::frameBufferHeight; ++y)
+  {
+    const uInt8* src = frame + y * TIAConstants::H_PIXEL;
+    uInt8* dst = myFramebuffer.data() + y * TIAConstants::H_PIXEL;
+
+    if(memcmp(src, dst, TIAConstants::H_PIXEL) != 0)
+    {
+      memcpy(dst, src, TIAConstants::H_PIXEL);
+      myDirtyLines.set(y);
+    }
+  }
 
-  myFrameBufferScanlines = myFrontBufferScanlines;
+  myFrameBufferScanlines = scanlines;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearFrameBuffer()
 {
   myFramebuffer.fill(0);
-  myFrontBuffer.fill(0);
+  std::fill_n(myFrontBuffer, FRAME_SIZE, 0);
+  myDirtyLines.set();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1304,19 +1462,66 @@ void TIA::onFrameComplete()
   mySystem->m6502().stop();
   myCyclesAtFrameStart = mySystem->cycles();
 
+  // Nothing has been rendered this frame
+  if (!myLastFrameKept) keepLastFrame(0);
+
   if (myXAtRenderingStart > 0)
-    std::fill_n(myBackBuffer.begin(), myXAtRenderingStart, 0);
+    std::fill_n(myBackBuffer, myXAtRenderingStart, 0);
 
   // Blank out any extra lines not drawn this frame
   const Int32 missingScanlines = myFrameManager->missingScanlines();
   if (missingScanlines > 0)
-    std::fill_n(myBackBuffer.begin() + TIAConstants::H_PIXEL * myFrameManager->getY(), missingScanlines * TIAConstants::H_PIXEL, 0);
+    std::fill_n(myBackBuffer + TIAConstants::H_PIXEL * myFrameManager->getY(), missingScanlines * TIAConstants::H_PIXEL, 0);
 
-  myFrontBuffer = myBackBuffer;
+  // All pixels not drawn this frame have been restored, so the buffers can be
+  // swapped instead of copied
+  std::swap(myFrontBuffer, myBackBuffer);
+  myLastFrameKept = false;
 
   myFrontBufferScanlines = scanlinesLastFrame();
 
   ++myFramesSinceLastRender;
+
+  if (myFramePublishing) {
+    PublishedFrame& frame = myPublishedFrames->back();
+    std::copy_n(myFrontBuffer, FRAME_SIZE, frame.pixels.begin());
+    frame.scanlines = myFrontBufferScanlines;
+    myPublishedFrames->publish();
+    myFramesSincePublishedRender.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (myHashingEnabled) {
+    myFrameHash = hashFrontBuffer();
+
+    // Chain the frame hashes (little-endian, so the result is portable)
+    std::array<uInt8, 8> bytes;
+    for (uInt32 i = 0; i < 8; ++i) bytes[i] = uInt8(myFrameHash >> (8 * i));
+    myVideoHash = XXH64::hash(bytes.data(), bytes.size(), myVideoHash);
+
+    if (myFrameHashCallback) myFrameHashCallback(frameCount(), myFrameHash);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::enableHashing(bool enable)
+{
+  myHashingEnabled = enable;
+  myAudio.enableHashing(enable);
+
+  if (enable) myFrameHash = hashFrontBuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 TIA::frameHash() const
+{
+  return myHashingEnabled ? myFrameHash : hashFrontBuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 TIA::hashFrontBuffer() const
+{
+  return XXH64::hash(myFrontBuffer,
+    std::min(myFrontBufferScanlines, TIAConstants::frameBufferHeight) * TIAConstants::H_PIXEL);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1434,8 +1639,10 @@ void TIA::applyRsync()
   const uInt32 x = myHctr > TIAConstants::H_BLANK_CLOCKS ? myHctr - TIAConstants::H_BLANK_CLOCKS : 0;
 
   myHctrDelta = TIAConstants::H_CLOCKS - 3 - myHctr;
-  if (myFrameManager->isRendering())
-    std::fill_n(myBackBuffer.begin() + myFrameManager->getY() * TIAConstants::H_PIXEL + x, TIAConstants::H_PIXEL - x, 0);
+  if (myFrameManager->isRendering()) {
+    std::fill_n(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL + x, TIAConstants::H_PIXEL - x, 0);
+    myLinePixelsDrawn = TIAConstants::H_PIXEL;
+  }
 
   myHctr = TIAConstants::H_CLOCKS - 3;
 }
@@ -1453,8 +1660,15 @@ void TIA::nextLine()
 
   myHstate = HState::blank;
   myHctrDelta = 0;
+  myLinePixelsDrawn = 0;
+
+  const bool wasRendering = myFrameManager->isRendering();
+  const uInt32 y = myFrameManager->getY();
 
   myFrameManager->nextLine();
+
+  if (wasRendering && !myFrameManager->isRendering())
+    keepLastFrame((y + 1) * TIAConstants::H_PIXEL);
   myMissile0.nextLine();
   myMissile1.nextLine();
   myPlayer0.nextLine();
@@ -1474,8 +1688,17 @@ void TIA::cloneLastLine()
 
   if (!myFrameManager->isRendering() || y == 0) return;
 
-  std::copy_n(myBackBuffer.begin() + (y-1) * TIAConstants::H_PIXEL, TIAConstants::H_PIXEL,
-      myBackBuffer.begin() + y * TIAConstants::H_PIXEL);
+  std::copy_n(myBackBuffer + (y-1) * TIAConstants::H_PIXEL, TIAConstants::H_PIXEL,
+      myBackBuffer + y * TIAConstants::H_PIXEL);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::keepLastFrame(uInt32 offset)
+{
+  if (offset < FRAME_SIZE)
+    std::copy(myFrontBuffer + offset, myFrontBuffer + FRAME_SIZE, myBackBuffer + offset);
+
+  myLastFrameKept = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1577,8 +1800,10 @@ void TIA::flushLineCache()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearHmoveComb()
 {
-  if (myFrameManager->isRendering() && myHstate == HState::blank)
-    std::fill_n(myBackBuffer.begin() + myFrameManager->getY() * TIAConstants::H_PIXEL, 8, myColorHBlank);
+  if (myFrameManager->isRendering() && myHstate == HState::blank) {
+    std::fill_n(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL, 8, myColorHBlank);
+    myLinePixelsDrawn = std::max(myLinePixelsDrawn, 8u);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -18,6 +18,8 @@
 #ifndef TIA_TIA
 #define TIA_TIA
 
+#include <atomic>
+#include <bitset>
 #include <functional>
 
 #include "bspf.hxx"
@@ -42,6 +44,7 @@
 #include "DelayQueueIterator.hxx"
 #include "Control.hxx"
 #include "System.hxx"
+#include "TripleBuffer.hxx"
 
 class AudioQueue;
 class DispatchResult;
@@ -233,11 +236,33 @@ class TIA : public Device
      */
     void renderToFrameBuffer();
 
+    /**
+      Publish each completed frame to a lock-free slot.  This allows another
+      thread to present the latest frame while the emulation keeps running
+      (see renderPublishedFrame).
+     */
+    void enableFramePublishing(bool enable);
+
+    /**
+      Copy the most recently published frame to the framebuffer.  Unlike
+      renderToFrameBuffer, this is safe to call while the emulation runs on
+      another thread.
+
+      @return  The number of frames completed since the last call
+     */
+    uInt32 renderPublishedFrame();
+
     /**
       Return the buffer that holds the currently drawing TIA frame
       (the TIA output widget needs this).
      */
-    uInt8* outputBuffer() { return myBackBuffer.data(); }
+    uInt8* outputBuffer() { return myBackBuffer; }
+
+    /**
+      Return the buffer that holds the last completed TIA frame (the TIA
+      output widget shows it below the electron beam).
+     */
+    const uInt8* lastFrameBuffer() const { return myFrontBuffer; }
 
     /**
       Returns a pointer to the internal frame buffer.
@@ -246,6 +271,57 @@ class TIA : public Device
 
     void clearFrameBuffer();
 
+    /**
+      One bit per scanline of the framebuffer.
+     */
+    using LineMask = std::bitset<TIAConstants::frameBufferHeight>;
+
+    /**
+      Answers which scanlines of the framebuffer changed since the last call
+      of this method, and marks all scanlines as unchanged.  This allows
+      converting and uploading only the changed parts of a frame.
+     */
+    LineMask takeDirtyLines() {
+      const LineMask lines = myDirtyLines;
+      myDirtyLines.reset();
+      return lines;
+    }
+
+    /**
+      Callback type for frame hashes (frame number, hash of the frame).
+     */
+    using onFrameHashCallback = std::function<void(uInt32, uInt64)>;
+
+    /**
+      Enable / disable hashing of each completed frame and audio fragment.
+      The video and audio hashes are chained over all frames (fragments)
+      since the last reset.  Hashing is disabled by default and costs nothing
+      in this case.
+     */
+    void enableHashing(bool enable);
+    bool hashingEnabled() const { return myHashingEnabled; }
+
+    /**
+      Inject a callback to be notified with the hash of each completed frame
+      (only called if hashing is enabled).
+     */
+    void setFrameHashCallback(const onFrameHashCallback& callback) {
+      myFrameHashCallback = callback;
+    }
+
+    /**
+      The hash of the last completed frame (the palette indices of all its
+      scanlines).  This is calculated on demand if hashing is disabled.
+     */
+    uInt64 frameHash() const;
+
+    /**
+      The hashes chained over all frames and audio fragments since the last
+      reset (only valid if hashing is enabled).
+     */
+    uInt64 videoHash() const { return myVideoHash; }
+    uInt64 audioHash() const { return myAudio.hash(); }
+
     /**
       Answers dimensional info about the framebuffer.
     */
@@ -581,6 +657,17 @@ class TIA : public Device
      */
     void onHalt();
 
+    /**
+     * Hash the scanlines of the last completed frame.
+     */
+    uInt64 hashFrontBuffer() const;
+
+    /**
+     * Copy the given frame to the framebuffer (only the scanlines which
+     * changed).
+     */
+    void copyToFrameBuffer(const uInt8* frame, uInt32 scanlines);
+
     /**
      * Execute colorClocks cycles of TIA simulation.
      */
@@ -632,6 +719,12 @@ class TIA : public Device
      */
     void cloneLastLine();
 
+    /**
+     * Rendering of the current frame has stopped. Pixels not drawn this frame
+     * (starting at the given offset) are taken over from the last frame.
+     */
+    void keepLastFrame(uInt32 offset);
+
     /**
      * Execute a delayed write. Called when the DelayQueue is pumped.
      */
@@ -716,6 +809,19 @@ class TIA : public Device
     ConsoleTimingProvider myTimingProvider;
     Settings& mySettings;
 
+    /**
+     * Handles of the settings applied by applyDeveloperSettings(), which is
+     * called on each reset and state load. The player/developer pairs are
+     * indexed by the value of "dev.settings".
+     */
+    struct SettingsHandles {
+      Settings::Handle devSettings, tiaType, plInvPhase, msInvPhase, blInvPhase,
+                       pfBitsDelay, pfColorDelay, plSwapDelay, blSwapDelay,
+                       tiaDriven;
+      std::array<Settings::Handle, 2> jitter, jitterRecovery, colorLoss;
+    };
+    SettingsHandles myHandles;
+
     /**
      * The length of the delay queue (maximum number of clocks delay)
      */
@@ -771,13 +877,38 @@ class TIA : public Device
     LatchedInput myInput0;
     LatchedInput myInput1;
 
-    // Pointer to the internal color-index-based frame buffer
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFramebuffer;
+    // A complete frame of color indices
+    using Frame = std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight>;
 
-    // The frame is rendered to the backbuffer and only copied to the framebuffer
-    // upon completion
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myBackBuffer;
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFrontBuffer;
+    // Pointer to the internal color-index-based frame buffer
+    Frame myFramebuffer;
+
+    // The frame is rendered to the back buffer. Upon completion, back and front
+    // buffer are swapped, and the front buffer is only copied to the framebuffer
+    // when it is rendered
+    std::array<Frame, 2> myFrames;
+    uInt8* myBackBuffer{myFrames[0].data()};
+    uInt8* myFrontBuffer{myFrames[1].data()};
+
+    // Swapping leaves the back buffer with the frame before last. Parts of the
+    // back buffer that are not drawn keep the last frame, so these are restored
+    // once rendering stops. Pixels of the current line drawn before the beam
+    // (HMOVE comb, RSYNC) are tracked separately.
+    bool myLastFrameKept{true};
+    uInt32 myLinePixelsDrawn{0};
+
+    // The scanlines of the framebuffer that changed since they were last taken
+    LineMask myDirtyLines;
+
+    // Completed frames, published for presentation from another thread
+    // (only allocated while publishing is enabled)
+    struct PublishedFrame {
+      Frame pixels;
+      uInt32 scanlines{0};
+    };
+    unique_ptr<TripleBuffer<PublishedFrame>> myPublishedFrames;
+    std::atomic<uInt32> myFramesSincePublishedRender{0};
+    bool myFramePublishing{false};
 
     // We snapshot frame statistics when the back buffer is copied to the front buffer
     // and when the front buffer is copied to the frame buffer
@@ -786,6 +917,11 @@ class TIA : public Device
     // Frames since the last time a frame was rendered to the render buffer
     uInt32 myFramesSinceLastRender{0};
 
+    // Hashes of the last completed frame and of all frames since reset
+    bool myHashingEnabled{false};
+    uInt64 myFrameHash{0}, myVideoHash{0};
+    onFrameHashCallback myFrameHashCallback{nullptr};
+
     /**
      * Setting this to true injects random values into undefined reads.
      */
@@ -119,7 +119,7 @@ void BrowserDialog::show(const string& startpath,
   {
     case FileLoad:
       _fileList->setListMode(FilesystemNode::ListMode::All);
-      _fileList->setNameFilter([&ext](const FilesystemNode& node) {
+      _fileList->setNameFilter([ext](const FilesystemNode& node) {
         return BSPF::endsWithIgnoreCase(node.getName(), ext);
       });
       _selected->setEditable(false);
@@ -129,7 +129,7 @@ void BrowserDialog::show(const string& startpath,
 
     case FileSave:
       _fileList->setListMode(FilesystemNode::ListMode::All);
-      _fileList->setNameFilter([&ext](const FilesystemNode& node) {
+      _fileList->setNameFilter([ext](const FilesystemNode& node) {
         return BSPF::endsWithIgnoreCase(node.getName(), ext);
       });
       _selected->setEditable(false);  // FIXME - disable user input for now
@@ -417,6 +417,12 @@ void Dialog::drawDialog()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Dialog::handleTick()
+{
+  Widget::tickChain(_firstWidget);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Dialog::handleText(char text)
 {
@@ -143,6 +143,8 @@ class Dialog : public GuiObject
     virtual bool handleJoyHat(int stick, int hat, JoyHatDir hdir, int button = JOY_CTRL_NONE);
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
     virtual Event::Type getJoyAxisEvent(int stick, JoyAxis axis, JoyDir adir, int button);
+    // Called regularly while the dialog is active
+    virtual void handleTick();
 
     Widget* findWidget(int x, int y) const; // Find the widget at pos x,y if any
 
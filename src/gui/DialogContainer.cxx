@@ -86,6 +86,8 @@ void DialogContainer::updateTime(uInt64 time)
                                 myCurrentHatDown.hdir);
     myHatRepeatTime = myTime + _REPEAT_SUSTAIN_DELAY;
   }
+
+  activeDialog->handleTick();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -239,7 +239,8 @@ void EmulationDialog::saveConfig()
     instance().console().initializeVideo();
     instance().createFrameBuffer();
 
-    instance().frameBuffer().tiaSurface().ntsc().enableThreading(myUseThreads->getState());
+    instance().frameBuffer().tiaSurface().ntsc().enableThreading(myUseThreads->getState(),
+        settings.getInt("threadcount"));
   }
 }
 
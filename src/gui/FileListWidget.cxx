@@ -33,6 +33,12 @@ FileListWidget::FileListWidget(GuiObject* boss, const GUI::Font& font,
   setTarget(this);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FileListWidget::~FileListWidget()
+{
+  stopLoading();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FileListWidget::setDirectory(const FilesystemNode& node,
                                   const string& select)
@@ -72,22 +78,117 @@ void FileListWidget::setDirectory(const FilesystemNode& node,
 void FileListWidget::setLocation(const FilesystemNode& node,
                                  const string& select)
 {
+  stopLoading();
+
   _node = node;
+  _selectedFile = select;
+  _selected = 0;
 
-  // Read in the data from the file system (start with an empty list)
+  // Start with an empty list; the entries are added while they are read
+  // from the file system (see handleTick)
   _fileList.clear();
   _fileList.reserve(512);
-  _node.getChildren(_fileList, _fsmode, _filter);
+  setList(StringList());
 
-  // Now fill the list widget with the names from the file list
-  StringList l;
-  for(const auto& file: _fileList)
-    l.push_back(file.getName());
+  _isLoading = true;
+  _selectPending = true;
+  _loaderDone = _cancelLoading = false;
+  _loader = std::thread([this, dir = _node, mode = _fsmode, filter = _filter]
+  {
+    FSList list;
+    list.reserve(512);
+    dir.getChildren(list, mode, filter, true,
+      [this](const FSList& nodes, size_t first)
+      {
+        std::lock_guard<std::mutex> lock(_loaderMutex);
+
+        _loadedList.insert(_loadedList.end(), nodes.begin() + first, nodes.end());
+        return !_cancelLoading;
+      }
+    );
+
+    std::lock_guard<std::mutex> lock(_loaderMutex);
+    _loaderDone = true;
+  });
+}
 
-  setList(l);
-  setSelected(select);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::stopLoading()
+{
+  if(!_loader.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(_loaderMutex);
+    _cancelLoading = true;
+  }
+  _loader.join();
+
+  _loadedList.clear();
+  _isLoading = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::handleTick()
+{
+  if(!_isLoading)
+    return;
 
-  ListWidget::recalc();
+  FSList nodes;
+  bool done;
+  {
+    std::lock_guard<std::mutex> lock(_loaderMutex);
+    nodes.swap(_loadedList);
+    done = _loaderDone;
+  }
+
+  if(!nodes.empty())
+  {
+    // Append the new entries, keeping the current position in the list
+    const size_t first = _fileList.size();
+    for(auto& file: nodes)
+    {
+      _list.push_back(file.getName());
+      _fileList.push_back(std::move(file));
+    }
+    ListWidget::recalc();
+    setDirty();
+
+    // Select the requested entry as soon as it arrives
+    if(_selectPending)
+    {
+      if(_selectedFile == "")
+      {
+        _selectPending = false;
+        setSelected(0);
+      }
+      else
+        for(size_t i = first; i < _list.size(); ++i)
+          if(_list[i] == _selectedFile)
+          {
+            _selectPending = false;
+            setSelected(int(i));
+            break;
+          }
+    }
+  }
+
+  if(done)
+  {
+    _loader.join();
+    _isLoading = false;
+
+    if(_selectPending)
+    {
+      _selectPending = false;
+      setSelected(0);
+    }
+
+    // Let the boss update its state for the complete list
+    setTarget(_boss);
+    sendCommand(ItemChanged, _selected, _id);
+    setTarget(this);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -109,7 +210,9 @@ void FileListWidget::reload()
 {
   if(_node.exists())
   {
-    _selectedFile = selected().getName();
+    // Keep the entry to select if it hasn't been listed yet
+    if(!_isLoading || !_selectPending)
+      _selectedFile = selected().getName();
     setLocation(_node, _selectedFile);
   }
 }
@@ -161,6 +264,7 @@ void FileListWidget::handleCommand(CommandSender* sender, int cmd, int data, int
 
     case ListWidget::kSelectionChangedCmd:
       _selected = data;
+      _selectPending = false;  // the user has chosen another entry meanwhile
       cmd = ItemChanged;
       break;
 
@@ -20,6 +20,9 @@
 
 class CommandSender;
 
+#include <mutex>
+#include <thread>
+
 #include "FSNode.hxx"
 #include "Stack.hxx"
 #include "StringListWidget.hxx"
@@ -37,7 +40,12 @@ class CommandSender;
   directory; instead the selection descends into the directory.
 
   Widgets wishing to enforce their own filename filtering are able
-  to use a 'NameFilter' as described below.
+  to use a 'NameFilter' as described below.  The filter is called on a
+  background thread, so it must not depend on any other widgets.
+
+  Directories are listed on a background thread, and the entries are shown
+  while they arrive, so that large directories don't block the UI.  An
+  ItemChanged signal is also sent when a listing is complete.
 */
 class FileListWidget : public StringListWidget
 {
@@ -50,7 +58,7 @@ class FileListWidget : public StringListWidget
   public:
     FileListWidget(GuiObject* boss, const GUI::Font& font,
                    int x, int y, int w, int h);
-    virtual ~FileListWidget() = default;
+    ~FileListWidget() override;
 
     /** Determines how to display files/folders; either setDirectory or reload
         must be called after any of these are called. */
@@ -74,11 +82,23 @@ class FileListWidget : public StringListWidget
 
     /** Gets current node(s) */
     const FilesystemNode& selected() {
+      if(_fileList.empty())
+        return _emptyNode;
+
       _selected = BSPF::clamp(_selected, 0U, uInt32(_fileList.size()-1));
       return _fileList[_selected];
     }
     const FilesystemNode& currentDir() const { return _node; }
 
+    /** Gets the node at the given offset from the selected one (if any) */
+    const FilesystemNode& neighbour(int offset) const {
+      const int index = int(_selected) + offset;
+      return index >= 0 && index < int(_fileList.size()) ? _fileList[index] : _emptyNode;
+    }
+
+    /** Answer whether the current directory is still being listed */
+    bool isLoading() const { return _isLoading; }
+
     static void setQuickSelectDelay(uInt64 time) { _QUICK_SELECT_DELAY = time; }
 
   private:
@@ -88,6 +108,12 @@ class FileListWidget : public StringListWidget
     /** Descend into currently selected directory */
     void selectDirectory();
 
+    /** Cancel the listing in progress (if any) and wait for its thread */
+    void stopLoading();
+
+    /** Show the entries listed by the background thread */
+    void handleTick() override;
+
     bool handleText(char text) override;
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
 
@@ -96,6 +122,17 @@ class FileListWidget : public StringListWidget
     FilesystemNode::NameFilter _filter;
     FilesystemNode _node;
     FSList _fileList;
+    FilesystemNode _emptyNode;
+
+    // The entries listed by the thread, which haven't been shown yet
+    std::thread _loader;
+    std::mutex _loaderMutex;
+    FSList _loadedList;
+    bool _loaderDone{false};
+    bool _cancelLoading{false};
+
+    bool _isLoading{false};
+    bool _selectPending{false};  // the entry to select hasn't been found yet
 
     Common::FixedStack<string> _history;
     uInt32 _selected{0};
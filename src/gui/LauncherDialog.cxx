@@ -36,6 +36,8 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomCache.hxx"
+#include "RomIndexer.hxx"
 #include "RomInfoWidget.hxx"
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
@@ -224,11 +226,6 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
   // Create (empty) context menu for ROM list options
   myMenu = make_unique<ContextMenu>(this, osystem.frameBuffer().launcherFont(), EmptyVarList);
 
-  // Create global props dialog, which is used to temporarily override
-  // ROM properties
-  myGlobalProps = make_unique<GlobalPropsDialog>(this,
-    myUseMinimalUI ? osystem.frameBuffer().launcherFont() : osystem.frameBuffer().font());
-
   // Do we show only ROMs or all files?
   bool onlyROMs = instance().settings().getBool("launcherroms");
   showOnlyROMs(onlyROMs);
@@ -255,7 +252,16 @@ const string& LauncherDialog::selectedRomMD5()
   // Lookup MD5, and if not present, cache it
   auto iter = myMD5List.find(currentNode().getPath());
   if(iter == myMD5List.end())
-    myMD5List[currentNode().getPath()] = MD5::hash(currentNode());
+  {
+    // Reuse the MD5 of a previous session, if the ROM is unchanged
+    RomCache::Entry cached = instance().romCache().get(currentNode());
+    if(cached.md5 == EmptyString)
+    {
+      cached.md5 = MD5::hash(currentNode());
+      instance().romCache().set(currentNode(), cached);
+    }
+    myMD5List[currentNode().getPath()] = cached.md5;
+  }
 
   return myMD5List[currentNode().getPath()];
 }
@@ -276,6 +282,7 @@ const FilesystemNode& LauncherDialog::currentDir() const
 void LauncherDialog::reload()
 {
   myMD5List.clear();
+  myIndexedDir = EmptyString;
   myList->reload();
 }
 
@@ -290,12 +297,17 @@ void LauncherDialog::loadConfig()
 
   // Assume that if the list is empty, this is the first time that loadConfig()
   // has been called (and we should reload the list)
-  if(myList->getList().empty())
+  if(myList->getList().empty() && !myList->isLoading())
   {
     FilesystemNode node(romdir == "" ? "~" : romdir);
     if(!(node.exists() && node.isDirectory()))
       node = FilesystemNode("~");
 
+    // Index the whole ROM library in the background; the directory shown
+    // (see updateUI) is indexed first
+    if(romdir != "")
+      instance().romIndexer().index(FilesystemNode(romdir), true);
+
     myList->setDirectory(node, instance().settings().getString("lastrom"));
     updateUI();
   }
@@ -325,28 +337,51 @@ void LauncherDialog::updateUI()
   myDir->setText(myList->currentDir().getShortPath());
 
   // Indicate how many files were found
-  ostringstream buf;
-  buf << (myList->getList().size() - 1) << " items found";
-  myRomCount->setLabel(buf.str());
+  showRomCount();
+
+  // Index the ROMs of a new directory in the background
+  if(myList->currentDir().getPath() != myIndexedDir)
+  {
+    myIndexedDir = myList->currentDir().getPath();
+    instance().romIndexer().index(myList->currentDir());
+  }
 
   // Update ROM info UI item
   loadRomInfo();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::showRomCount()
+{
+  if(myList->isLoading())
+    myRomCount->setLabel("Loading" + ELLIPSIS);
+  else
+  {
+    ostringstream buf;
+    buf << (myList->getList().size() - 1) << " items found";
+    myRomCount->setLabel(buf.str());
+  }
+  myIndexProgress = -1;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::applyFiltering()
 {
+  // The filter is used by the thread listing the directory, so it must not
+  // access any widgets
+  const bool showOnlyROMs = myShowOnlyROMs;
+  const string pattern = myPattern ? myPattern->getText() : EmptyString;
+
   myList->setNameFilter(
-    [&](const FilesystemNode& node) {
+    [showOnlyROMs, pattern](const FilesystemNode& node) {
       if(!node.isDirectory())
       {
         // Do we want to show only ROMs or all files?
-        if(myShowOnlyROMs && !Bankswitch::isValidRomName(node))
+        if(showOnlyROMs && !Bankswitch::isValidRomName(node))
           return false;
 
         // Skip over files that don't match the pattern in the 'pattern' textbox
-        if(myPattern && myPattern->getText() != "" &&
-          !BSPF::containsIgnoreCase(node.getName(), myPattern->getText()))
+        if(pattern != "" && !BSPF::containsIgnoreCase(node.getName(), pattern))
           return false;
       }
       return true;
@@ -435,6 +470,15 @@ void LauncherDialog::loadRomInfo()
     myRomInfoWidget->setProperties(currentNode(), md5);
   else
     myRomInfoWidget->clearProperties();
+
+  // The neighbours are likely to be selected next, so their snapshots are
+  // decoded in the background
+  for(int offset: {1, -1, 2, -2})
+  {
+    const FilesystemNode& node = myList->neighbour(offset);
+    if(!node.isDirectory() && Bankswitch::isValidRomName(node))
+      myRomInfoWidget->prefetch(node);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -443,7 +487,7 @@ void LauncherDialog::handleContextMenu()
   const string& cmd = myMenu->getSelectedTag().toString();
 
   if(cmd == "override")
-    myGlobalProps->open();
+    openGlobalProps();
   else if(cmd == "reload")
     reload();
 }
@@ -470,7 +514,7 @@ void LauncherDialog::handleKeyDown(StellaKey key, StellaMod mod, bool repeated)
     {
       case KBDK_F8: // front  ("Skill P2")
         if (!currentNode().isDirectory() && Bankswitch::isValidRomName(currentNode()))
-          myGlobalProps->open();
+          openGlobalProps();
         break;
       case KBDK_F4: // back ("COLOR", "B/W")
         openSettings();
@@ -511,7 +555,7 @@ void LauncherDialog::handleJoyUp(int stick, int button)
 
   if (button == 1 && (e == Event::UIOK || e == Event::NoType) &&
       !currentNode().isDirectory() && Bankswitch::isValidRomName(currentNode()))
-    myGlobalProps->open();
+    openGlobalProps();
   if (button == 3 && (e == Event::Event::UITabPrev || e == Event::NoType))
     openSettings();
   else if (!myEventHandled)
@@ -547,6 +591,30 @@ Event::Type LauncherDialog::getJoyAxisEvent(int stick, JoyAxis axis, JoyDir adir
   return e;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::handleTick()
+{
+  Dialog::handleTick();
+
+  // Show the progress of the ROM indexer instead of the number of items
+  const RomIndexer& indexer = instance().romIndexer();
+  const int progress = indexer.isBusy() && indexer.found() > 0
+    ? int(uInt64(indexer.indexed()) * 100 / indexer.found()) : -1;
+
+  if(progress == myIndexProgress)
+    return;
+
+  if(progress >= 0)
+  {
+    ostringstream buf;
+    buf << "Indexing " << progress << "%";
+    myRomCount->setLabel(buf.str());
+    myIndexProgress = progress;
+  }
+  else
+    showRomCount();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::handleMouseDown(int x, int y, MouseButton b, int clickCount)
 {
@@ -600,7 +668,7 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
 
     case ListWidget::kLongButtonPressCmd:
       if (!currentNode().isDirectory() && Bankswitch::isValidRomName(currentNode()))
-        myGlobalProps->open();
+        openGlobalProps();
       myEventHandled = true;
       break;
 
@@ -675,3 +743,14 @@ void LauncherDialog::openSettings()
     myOptionsDialog->open();
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::openGlobalProps()
+{
+  // Create global props dialog, which is used to temporarily override
+  // ROM properties
+  if (myGlobalProps == nullptr)
+    myGlobalProps = make_unique<GlobalPropsDialog>(this, myUseMinimalUI
+      ? instance().frameBuffer().launcherFont() : instance().frameBuffer().font());
+  myGlobalProps->open();
+}
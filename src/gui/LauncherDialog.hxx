@@ -106,11 +106,13 @@ class LauncherDialog : public Dialog
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
     void handleJoyDown(int stick, int button, bool longPress) override;
     void handleJoyUp(int stick, int button) override;
+    void handleTick() override;
     Event::Type getJoyAxisEvent(int stick, JoyAxis axis, JoyDir adir, int button) override;
 
     void loadConfig() override;
     void saveConfig() override;
     void updateUI();
+    void showRomCount();
     void applyFiltering();
 
     float getRomInfoZoom(int listHeight) const;
@@ -122,6 +124,7 @@ class LauncherDialog : public Dialog
     void showOnlyROMs(bool state);
     void setDefaultDir();
     void openSettings();
+    void openGlobalProps();
 
   private:
     unique_ptr<OptionsDialog> myOptionsDialog;
@@ -150,6 +153,12 @@ class LauncherDialog : public Dialog
 
     int mySelectedItem{0};
 
+    // Progress of the ROM indexer shown (in percent, -1 when idle)
+    int myIndexProgress{-1};
+
+    // The directory last passed to the ROM indexer
+    string myIndexedDir;
+
     bool myShowOnlyROMs{false};
     bool myUseMinimalUI{false};
     bool myEventHandled{false};
@@ -50,7 +50,9 @@ OptionsDialog::OptionsDialog(OSystem& osystem, DialogContainer& parent,
                              GuiObject* boss, int max_w, int max_h, Menu::AppMode mode)
   : Dialog(osystem, parent, osystem.frameBuffer().font(), "Options"),
     myBoss(boss),
-    myMode(mode)
+    myMode(mode),
+    myMaxWidth(max_w),
+    myMaxHeight(max_h)
 {
   // do not show basic settings options in debugger
   bool minSettings = osystem.settings().getBool("minimal_ui") && mode != Menu::AppMode::debugger;
@@ -139,21 +141,6 @@ OptionsDialog::OptionsDialog(OSystem& osystem, DialogContainer& parent,
   wid.push_back(b);
   addCancelWidget(b);
 
-  // Now create all the dialogs attached to each menu button
-  myVideoDialog    = make_unique<VideoAudioDialog>(osystem, parent, _font, max_w, max_h);
-  myEmulationDialog= make_unique<EmulationDialog>(osystem, parent, _font, max_w, max_h);
-  myInputDialog    = make_unique<InputDialog>(osystem, parent, _font, max_w, max_h);
-  myUIDialog       = make_unique<UIDialog>(osystem, parent, _font, boss, max_w, max_h);
-  mySnapshotDialog = make_unique<SnapshotDialog>(osystem, parent, _font, max_w, max_h);
-  myDeveloperDialog = make_unique<DeveloperDialog>(osystem, parent, _font, max_w, max_h);
-  myGameInfoDialog = make_unique<GameInfoDialog>(osystem, parent, _font, this, max_w, max_h);
-#ifdef CHEATCODE_SUPPORT
-  myCheatCodeDialog = make_unique<CheatCodeDialog>(osystem, parent, _font);
-#endif
-  myRomAuditDialog = make_unique<RomAuditDialog>(osystem, parent, _font, max_w, max_h);
-  myHelpDialog      = make_unique<HelpDialog>(osystem, parent, _font);
-  myAboutDialog     = make_unique<AboutDialog>(osystem, parent, _font);
-
   addToFocusList(wid);
 
   // Certain buttons are disabled depending on mode
@@ -210,15 +197,20 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
       break;
 
     case kEmuCmd:
+      if(myEmulationDialog == nullptr)
+        myEmulationDialog = make_unique<EmulationDialog>(instance(), parent(),
+            instance().frameBuffer().font(), myMaxWidth, myMaxHeight);
       myEmulationDialog->open();
       break;
 
     case kVidCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(myVideoDialog == nullptr)
+        getDynamicBounds(w, h);
       if(myVideoDialog == nullptr || myVideoDialog->shouldResize(w, h))
       {
         myVideoDialog = make_unique<VideoAudioDialog>(instance(), parent(),
@@ -229,10 +221,12 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     }
     case kInptCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(myInputDialog == nullptr)
+        getDynamicBounds(w, h);
       if(myInputDialog == nullptr || myInputDialog->shouldResize(w, h))
       {
         myInputDialog = make_unique<InputDialog>(instance(), parent(),
@@ -245,10 +239,12 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kUsrIfaceCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(myUIDialog == nullptr)
+        getDynamicBounds(w, h);
       if(myUIDialog == nullptr || myUIDialog->shouldResize(w, h))
       {
         myUIDialog = make_unique<UIDialog>(instance(), parent(),
@@ -261,10 +257,12 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kSnapCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(mySnapshotDialog == nullptr)
+        getDynamicBounds(w, h);
       if(mySnapshotDialog == nullptr || mySnapshotDialog->shouldResize(w, h))
       {
         mySnapshotDialog = make_unique<SnapshotDialog>(instance(), parent(),
@@ -276,10 +274,12 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kDevelopCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(myDeveloperDialog == nullptr)
+        getDynamicBounds(w, h);
       if(myDeveloperDialog == nullptr || myDeveloperDialog->shouldResize(w, h))
       {
         myDeveloperDialog = make_unique<DeveloperDialog>(instance(), parent(),
@@ -291,10 +291,12 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kInfoCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
 
+      if(myGameInfoDialog == nullptr)
+        getDynamicBounds(w, h);
       if(myGameInfoDialog == nullptr || myGameInfoDialog->shouldResize(w, h))
       {
         myGameInfoDialog = make_unique<GameInfoDialog>(instance(), parent(),
@@ -306,18 +308,24 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
 #ifdef CHEATCODE_SUPPORT
     case kCheatCmd:
+      if(myCheatCodeDialog == nullptr)
+        myCheatCodeDialog = make_unique<CheatCodeDialog>(instance(), parent(),
+            instance().frameBuffer().font());
       myCheatCodeDialog->open();
       break;
 #endif
 
     case kAuditCmd:
+      if(myRomAuditDialog == nullptr)
+        myRomAuditDialog = make_unique<RomAuditDialog>(instance(), parent(),
+            instance().frameBuffer().font(), myMaxWidth, myMaxHeight);
       myRomAuditDialog->open();
       break;
 
     case kLoggerCmd:
     {
-      // This dialog is resizable under certain conditions, so we need
-      // to re-create it as necessary
+      // This dialog is created on first use, and is resizable under certain
+      // conditions, so we need to re-create it as necessary
       uInt32 w = 0, h = 0;
       bool uselargefont = getDynamicBounds(w, h);
 
@@ -331,10 +339,16 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     }
 
     case kHelpCmd:
+      if(myHelpDialog == nullptr)
+        myHelpDialog = make_unique<HelpDialog>(instance(), parent(),
+            instance().frameBuffer().font());
       myHelpDialog->open();
       break;
 
     case kAboutCmd:
+      if(myAboutDialog == nullptr)
+        myAboutDialog = make_unique<AboutDialog>(instance(), parent(),
+            instance().frameBuffer().font());
       myAboutDialog->open();
       break;
 
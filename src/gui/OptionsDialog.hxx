@@ -75,6 +75,9 @@ class OptionsDialog : public Dialog
     // Indicates if this dialog is used for global (vs. in-game) settings
     Menu::AppMode myMode{Menu::AppMode::emulator};
 
+    // The initial size of the dialogs, which are created on first use
+    uInt32 myMaxWidth{0}, myMaxHeight{0};
+
     enum {
       kBasSetCmd   = 'BAST',
       kVidCmd      = 'VIDO',
@@ -21,14 +21,14 @@
 #include "BrowserDialog.hxx"
 #include "DialogContainer.hxx"
 #include "EditTextWidget.hxx"
-#include "ProgressDialog.hxx"
 #include "FSNode.hxx"
 #include "Font.hxx"
 #include "MessageBox.hxx"
 #include "OSystem.hxx"
 #include "FrameBuffer.hxx"
-#include "MD5.hxx"
 #include "Props.hxx"
+#include "RomCache.hxx"
+#include "RomIndexer.hxx"
 #include "PropsSet.hxx"
 #include "Settings.hxx"
 #include "RomAuditDialog.hxx"
@@ -106,22 +106,101 @@ void RomAuditDialog::loadConfig()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void RomAuditDialog::auditRoms()
+void RomAuditDialog::startAudit()
 {
-  const string& auditPath = myRomPath->getText();
   myResults1->setText("");
   myResults2->setText("");
 
-  FilesystemNode node(auditPath);
-  FSList files;
-  files.reserve(2048);
-  node.getChildren(files, FilesystemNode::ListMode::FilesOnly);
+  myAuditDir = FilesystemNode(myRomPath->getText());
+  myAuditFiles.clear();
+  myAuditFiles.reserve(2048);
+  myAuditDir.getChildren(myAuditFiles, FilesystemNode::ListMode::FilesOnly);
 
-  // Create a progress dialog box to show the progress of processing
-  // the ROMs, since this is usually a time-consuming operation
-  ProgressDialog progress(this, instance().frameBuffer().font(),
-                          "Auditing ROM files ...");
-  progress.setRange(0, int(files.size()) - 1, 5);
+  // Let the ROM indexer hash the ROMs on all its threads; any other pending
+  // indexing is dropped, so that only the audited ROMs are waited for
+  // The progress is shown (and the audit finished) in handleTick
+  RomIndexer& indexer = instance().romIndexer();
+  indexer.cancel();
+  indexer.index(myAuditDir);
+
+  myIsAuditing = true;
+  myAuditRequeued = false;
+  myAuditProgress = -1;
+  _okWidget->setEnabled(false);
+  _cancelWidget->setEnabled(false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomAuditDialog::handleTick()
+{
+  Dialog::handleTick();
+
+  if(!myIsAuditing)
+    return;
+
+  RomIndexer& indexer = instance().romIndexer();
+  if(indexer.isBusy())
+  {
+    const int progress = indexer.found() > 0
+      ? int(uInt64(indexer.indexed()) * 100 / indexer.found()) : 0;
+
+    if(progress != myAuditProgress)
+    {
+      ostringstream buf;
+      buf << "Auditing ROMs " << progress << "%";
+      setTitle(buf.str());
+      myAuditProgress = progress;
+    }
+    return;
+  }
+
+  indexer.update();
+
+  // ROMs which were queued before the audit, but dropped for it, have no
+  // cache entry yet; they are indexed once more before the audit finishes
+  if(!myAuditRequeued && requeueMissingRoms())
+    return;
+
+  finishAudit();
+
+  myIsAuditing = false;
+  setTitle("Audit ROMs");
+  _okWidget->setEnabled(true);
+  _cancelWidget->setEnabled(true);
+
+  // Continue indexing the ROM library, which was dropped for the audit
+  const string& romdir = instance().settings().getString("romdir");
+  if(romdir != "")
+    indexer.index(FilesystemNode(romdir), true);
+
+  instance().launcher().reload();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomAuditDialog::requeueMissingRoms()
+{
+  RomIndexer& indexer = instance().romIndexer();
+  bool requeued = false;
+
+  for(const auto& file: myAuditFiles)
+  {
+    if(file.isFile() && Bankswitch::isValidRomName(file) &&
+       instance().romCache().get(file).md5 == EmptyString)
+    {
+      indexer.index(file);
+      requeued = true;
+    }
+  }
+  myAuditRequeued = true;
+
+  return requeued;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomAuditDialog::finishAudit()
+{
+  FSList& files = myAuditFiles;
+  const FilesystemNode& node = myAuditDir;
 
   Properties props;
   uInt32 renamed = 0, notfound = 0;
@@ -133,10 +212,11 @@ void RomAuditDialog::auditRoms()
     {
       bool renameSucceeded = false;
 
-      // Calculate the MD5 so we can get the rest of the info
-      // from the PropertiesSet (stella.pro)
-      const string& md5 = MD5::hash(files[idx]);
-      if(instance().propSet().getMD5(md5, props))
+      // Get the MD5 so we can get the rest of the info
+      // from the PropertiesSet (stella.pro); ROMs which couldn't be indexed
+      // have none
+      const string& md5 = instance().romCache().get(files[idx]).md5;
+      if(md5 != EmptyString && instance().propSet().getMD5(md5, props))
       {
         const string& name = props.get(PropType::Cart_Name);
 
@@ -154,10 +234,8 @@ void RomAuditDialog::auditRoms()
         ++notfound;
     }
 
-    // Update the progress bar, indicating one more ROM has been processed
-    progress.setProgress(idx);
   }
-  progress.close();
+  myAuditFiles.clear();
 
   myResults1->setText(std::to_string(renamed));
   myResults2->setText(std::to_string(notfound));
@@ -188,8 +266,13 @@ void RomAuditDialog::handleCommand(CommandSender* sender, int cmd,
       break;
 
     case kConfirmAuditCmd:
-      auditRoms();
-      instance().launcher().reload();
+      startAudit();
+      break;
+
+    case GuiObject::kCloseCmd:
+      // The dialog stays open until the audit is finished
+      if(!myIsAuditing)
+        Dialog::handleCommand(sender, cmd, data, 0);
       break;
 
     case kChooseAuditDirCmd:
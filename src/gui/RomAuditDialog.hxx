@@ -41,9 +41,13 @@ class RomAuditDialog : public Dialog
 
   private:
     void loadConfig() override;
-    void auditRoms();
+    void startAudit();
+    bool requeueMissingRoms();
+    void finishAudit();
     void createBrowser(const string& title);
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
+    void handleTick() override;
+    void processCancel() override { if(!myIsAuditing) close(); }
 
   private:
     enum {
@@ -66,6 +70,13 @@ class RomAuditDialog : public Dialog
     // Show a message about the dangers of using this function
     unique_ptr<GUI::MessageBox> myConfirmMsg;
 
+    // The audit in progress, whose ROMs are hashed by the ROM indexer
+    FilesystemNode myAuditDir;
+    FSList myAuditFiles;
+    bool myIsAuditing{false};
+    bool myAuditRequeued{false};  // ROMs not cached yet have been queued again
+    int myAuditProgress{-1};
+
     // Maximum width and height for this dialog
     int myMaxWidth{0}, myMaxHeight{0};
 
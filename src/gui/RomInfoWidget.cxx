@@ -27,7 +27,9 @@
 #include "Logger.hxx"
 #include "Props.hxx"
 #include "PNGLibrary.hxx"
+#include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "RomCache.hxx"
 #include "Rect.hxx"
 #include "Widget.hxx"
 #include "RomInfoWidget.hxx"
@@ -64,6 +66,9 @@ void RomInfoWidget::setProperties(const FilesystemNode& node, const string& md5)
 void RomInfoWidget::clearProperties()
 {
   myHaveProperties = mySurfaceIsValid = false;
+#ifdef PNG_SUPPORT
+  myImagePending = false;
+#endif
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
 
@@ -79,7 +84,30 @@ void RomInfoWidget::reloadProperties(const FilesystemNode& node)
   // by saving a different image or through a change in video renderer,
   // so we reload the properties
   if(myHaveProperties)
+  {
+#ifdef PNG_SUPPORT
+    myThumbnails.clear();
+#endif
     parseProperties(node);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::prefetch(const FilesystemNode& node)
+{
+#ifdef PNG_SUPPORT
+  // The MD5 must not be calculated here, as this would read the ROM
+  const string md5 = instance().romCache().get(node).md5;
+  if(md5 == EmptyString)
+    return;
+
+  Properties props;
+  instance().propSet().getMD5(md5, props);
+  const string name = props.get(PropType::Cart_Name) != EmptyString
+      ? props.get(PropType::Cart_Name) : node.getNameWithExt("");
+
+  myThumbnails.prefetch(instance().snapshotLoadDir() + name + ".png");
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -104,30 +132,17 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
 
 #ifdef PNG_SUPPORT
   // Get a valid filename representing a snapshot file for this rom
-  const string& filename = instance().snapshotLoadDir() +
+  myImageFile = instance().snapshotLoadDir() +
       myProperties.get(PropType::Cart_Name) + ".png";
 
-  // Read the PNG file
-  try
-  {
-    instance().png().loadImage(filename, *mySurface);
-
-    // Scale surface to available image area
-    const Common::Rect& src = mySurface->srcRect();
-    float scale = std::min(float(myAvail.w) / src.w(), float(myAvail.h) / src.h()) *
-        instance().frameBuffer().hidpiScaleFactor();
-    mySurface->setDstSize(uInt32(src.w() * scale), uInt32(src.h() * scale));
-    mySurfaceIsValid = true;
-  }
-  catch(const runtime_error& e)
-  {
-    mySurfaceErrorMsg = e.what();
-  }
+  // The snapshot is decoded in the background, unless it has been decoded
+  // before; in that case, it is shown immediately
+  loadImage();
 #else
   mySurfaceErrorMsg = "PNG image loading not supported";
-#endif
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
+#endif
 
   // Now add some info for the message box below the image
   myRomInfo.push_back("Name: " + myProperties.get(PropType::Cart_Name));
@@ -145,21 +160,55 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
   string bsDetected = myProperties.get(PropType::Cart_Type);
   try
   {
+    RomCache::Entry cached = instance().romCache().get(node);
+    string& leftCached = !swappedPorts ? cached.leftController : cached.rightController;
+    string& rightCached = !swappedPorts ? cached.rightController : cached.leftController;
+    const bool rominfo = instance().settings().getBool("rominfo");
+
+    // Use the results of a previous autodetection, if there are any
+    if(!rominfo)
+    {
+      if(leftType == Controller::Type::Unknown)
+        leftType = Controller::getType(leftCached);
+      if(rightType == Controller::Type::Unknown)
+        rightType = Controller::getType(rightCached);
+      if(bsDetected == "AUTO" && cached.bankswitch != "")
+        bsDetected = cached.bankswitch;
+    }
+
     ByteBuffer image;
-    string md5 = "";  size_t size = 0;
+    string md5 = cached.md5;  size_t size = 0;
 
-    if(node.exists() && !node.isDirectory() &&
+    if(leftType != Controller::Type::Unknown && rightType != Controller::Type::Unknown &&
+       bsDetected != "AUTO" && !rominfo)
+    {
+      left = Controller::getName(leftType);
+      right = Controller::getName(rightType);
+    }
+    else if(node.exists() && !node.isDirectory() &&
       (image = instance().openROM(node, md5, size)) != nullptr)
     {
+      const SignatureIndex index(image.get(), size);
+
       Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-      left = ControllerDetector::detectName(image.get(), size, leftType,
+      const Controller::Type leftDetected = ControllerDetector::detectType(index, leftType,
           !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
           instance().settings());
-      right = ControllerDetector::detectName(image.get(), size, rightType,
+      const Controller::Type rightDetected = ControllerDetector::detectType(index, rightType,
           !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
           instance().settings());
+      if(leftType == Controller::Type::Unknown)
+        leftCached = Controller::getPropName(leftDetected);
+      if(rightType == Controller::Type::Unknown)
+        rightCached = Controller::getPropName(rightDetected);
+      left = Controller::getName(leftDetected);
+      right = Controller::getName(rightDetected);
       if (bsDetected == "AUTO")
-        bsDetected = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+        bsDetected = cached.bankswitch =
+          Bankswitch::typeToName(CartDetector::autodetectType(index));
+
+      cached.md5 = md5;
+      instance().romCache().set(node, cached);
     }
   }
   catch(const runtime_error&)
@@ -174,6 +223,52 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
     myRomInfo.push_back("Type: " + Bankswitch::typeToDesc(Bankswitch::nameToType(bsDetected)));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::loadImage()
+{
+#ifdef PNG_SUPPORT
+  shared_ptr<const ThumbnailCache::Image> image;
+
+  myImagePending = false;
+  switch(myThumbnails.get(myImageFile, image, mySurfaceErrorMsg))
+  {
+    case ThumbnailCache::State::pending:
+      myImagePending = true;
+      break;
+
+    case ThumbnailCache::State::ready:
+    {
+      instance().png().loadImage(*image, *mySurface);
+
+      // Scale surface to available image area
+      const Common::Rect& src = mySurface->srcRect();
+      float scale = std::min(float(myAvail.w) / src.w(), float(myAvail.h) / src.h()) *
+          instance().frameBuffer().hidpiScaleFactor();
+      mySurface->setDstSize(uInt32(src.w() * scale), uInt32(src.h() * scale));
+      mySurfaceIsValid = true;
+      break;
+    }
+
+    case ThumbnailCache::State::failed:
+      break;
+  }
+  mySurface->setVisible(mySurfaceIsValid);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::handleTick()
+{
+#ifdef PNG_SUPPORT
+  if(myHaveProperties && myImagePending)
+  {
+    loadImage();
+    if(!myImagePending)
+      setDirty();
+  }
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::drawWidget(bool hilite)
 {
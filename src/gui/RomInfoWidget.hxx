@@ -26,6 +26,9 @@ namespace Common {
 
 #include "Widget.hxx"
 #include "bspf.hxx"
+#ifdef PNG_SUPPORT
+  #include "ThumbnailCache.hxx"
+#endif
 
 class RomInfoWidget : public Widget
 {
@@ -39,12 +42,25 @@ class RomInfoWidget : public Widget
     void clearProperties();
     void reloadProperties(const FilesystemNode& node);
 
+    /**
+      Decode the snapshot of a ROM in the background, since it will
+      probably be selected soon (e.g. a neighbour of the selected ROM).
+      Only ROMs with a known MD5 are considered.
+    */
+    void prefetch(const FilesystemNode& node);
+
   protected:
     void drawWidget(bool hilite) override;
 
+    /** Show the snapshot once it has been decoded */
+    void handleTick() override;
+
   private:
     void parseProperties(const FilesystemNode& node);
 
+    /** Load the decoded snapshot into the surface, if it is available */
+    void loadImage();
+
   private:
     // Surface pointer holding the PNG image
     shared_ptr<FBSurface> mySurface;
@@ -64,6 +80,15 @@ class RomInfoWidget : public Widget
     // Indicates if an error occurred in creating/displaying the surface
     string mySurfaceErrorMsg;
 
+#ifdef PNG_SUPPORT
+    // The recently shown and prefetched snapshots
+    ThumbnailCache myThumbnails;
+
+    // The snapshot of the current ROM, and whether it is still being decoded
+    string myImageFile;
+    bool myImagePending{false};
+#endif
+
     // How much space available for the PNG image
     Common::Size myAvail;
 
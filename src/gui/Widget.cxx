@@ -295,6 +295,16 @@ void Widget::setDirtyInChain(Widget* start)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Widget::tickChain(Widget* start)
+{
+  while(start)
+  {
+    start->handleTick();
+    start = start->_next;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StaticTextWidget::StaticTextWidget(GuiObject* boss, const GUI::Font& font,
                                    int x, int y, int w, int h,
@@ -81,6 +81,8 @@ class Widget : public GuiObject
     virtual void handleJoyAxis(int stick, JoyAxis axis, JoyDir adir, int button = JOY_CTRL_NONE) { }
     virtual bool handleJoyHat(int stick, int hat, JoyHatDir hdir, int button = JOY_CTRL_NONE) { return false; }
     virtual bool handleEvent(Event::Type event) { return false; }
+    // Called regularly while the dialog of the widget is active
+    virtual void handleTick() { }
 
     void setDirty() override;
     void draw() override;
@@ -166,6 +168,9 @@ class Widget : public GuiObject
     /** Sets all widgets in this chain to be dirty (must be redrawn) */
     static void setDirtyInChain(Widget* start);
 
+    /** Lets all widgets in this chain handle a tick */
+    static void tickChain(Widget* start);
+
   private:
     // Following constructors and assignment operators not supported
     Widget() = delete;
@@ -148,21 +148,16 @@ sub num_prop_types {
   return keys( %prop_type );
 }
 
-# Convert a properties set into a C++ compatible string
-sub build_prop_string {
+# Get the (type, value) pairs of all non-empty properties in a properties
+# set which differ from the defaults (the MD5 is not included)
+sub build_prop_fields {
   my @array = @_;
-  my $result = "  { ";
-  my @items = ();
-  for (my $i = 0; $i < @array; $i++) {
-    if($prop_defaults[$i] ne $array[$i]) {
-      push(@items, "\"$array[$i]\"");
-    } else {
-      push(@items, "\"\"");
+  my @fields = ();
+  for (my $i = 1; $i < @array; $i++) {
+    if($array[$i] ne "" && $prop_defaults[$i] ne $array[$i]) {
+      push(@fields, [ $i, $array[$i] ]);
     }
   }
 
-  $result .= join(", ", @items);
-  $result .= " }";
-
-  return $result;
+  return @fields;
 }
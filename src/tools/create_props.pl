@@ -34,10 +34,73 @@ else
 
 my %propset = PropSet::load_prop_set($infile);
 my $setsize = keys (%propset);
-my $typesize = PropSet::num_prop_types();
 
 printf "Valid properties found: $setsize\n";
 
+# Build a minimal perfect hash of the binary md5sums: every md5sum is put
+# into a bucket by its hash with seed 0; then the buckets are placed, largest
+# first, by searching a seed which maps all their md5sums to free slots
+# Buckets with a single md5sum directly store their slot (as -slot-1)
+my @buckets = ();
+for my $key ( sort keys %propset )
+{
+  push(@{ $buckets[md5_hash($key, 0) % $setsize] }, $key);
+}
+
+my @slots = ();
+my @seeds = (0) x $setsize;
+for my $b ( sort { @{ $buckets[$b] } <=> @{ $buckets[$a] } || $a <=> $b }
+            grep { defined $buckets[$_] && @{ $buckets[$_] } > 1 } 0 .. $setsize-1 )
+{
+  for (my $seed = 1; ; $seed++)
+  {
+    my %used = ();
+    my $ok = 1;
+    for my $key ( @{ $buckets[$b] } )
+    {
+      my $slot = md5_hash($key, $seed) % $setsize;
+      if (defined $slots[$slot] || $used{$slot}) {
+        $ok = 0;
+        last;
+      }
+      $used{$slot} = $key;
+    }
+    if ($ok)
+    {
+      $slots[$_] = $used{$_} for keys %used;
+      $seeds[$b] = $seed;
+      last;
+    }
+  }
+}
+my @free = grep { !defined $slots[$_] } 0 .. $setsize-1;
+for my $b ( grep { defined $buckets[$_] && @{ $buckets[$_] } == 1 } 0 .. $setsize-1 )
+{
+  my $slot = shift @free;
+  $slots[$slot] = $buckets[$b][0];
+  $seeds[$b] = -$slot - 1;
+}
+
+# Intern all property values in a single string pool
+my @strings = ();
+my %string_index = ();
+my @fields = ();
+my @first_field = ();
+for my $key ( @slots )
+{
+  push(@first_field, scalar @fields);
+  for my $field ( PropSet::build_prop_fields(@{ $propset{$key} }) )
+  {
+    my ($type, $value) = @$field;
+    if (!defined $string_index{$value}) {
+      $string_index{$value} = @strings;
+      push(@strings, $value);
+    }
+    push(@fields, "{ $type, $string_index{$value} }");
+  }
+}
+push(@first_field, scalar @fields);
+
 # Construct the output file in C++ format
 open(OUTFILE, ">$outfile");
 print OUTFILE "//============================================================================\n";
@@ -65,24 +128,70 @@ print OUTFILE "  This code is generated using the 'create_props.pl' script,\n";
 print OUTFILE "  located in the src/tools directory.  All properties changes\n";
 print OUTFILE "  should be made in stella.pro, and then this file should be\n";
 print OUTFILE "  regenerated and the application recompiled.\n";
+print OUTFILE "\n";
+print OUTFILE "  The entries are stored in the slots of a minimal perfect hash of their\n";
+print OUTFILE "  binary md5sum (see PropertiesSet::defPropsSlot).  Only the properties\n";
+print OUTFILE "  differing from the defaults are stored, as indices into a pool of all\n";
+print OUTFILE "  distinct values.\n";
 print OUTFILE "*/\n";
 print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_SIZE = " . $setsize . ";";
+print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_FIELDS = " . scalar @fields . ";";
+print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_STRINGS = " . scalar @strings . ";";
 print OUTFILE "\n\n";
-print OUTFILE "static const BSPF::array2D<const char*, DEF_PROPS_SIZE, " . $typesize . "> DefProps = {{\n";
 
-# Walk the hash map and print each item in order of md5sum
-my $idx = 0;
-for my $key ( sort keys %propset )
+print OUTFILE "struct DefPropsEntry {\n";
+print OUTFILE "  uInt64 md5Hi, md5Lo;\n";
+print OUTFILE "  uInt32 firstField;  // the fields end with the first one of the next entry\n";
+print OUTFILE "};\n";
+print OUTFILE "\n";
+print OUTFILE "struct DefPropsField {\n";
+print OUTFILE "  uInt8 type;\n";
+print OUTFILE "  uInt16 value;  // index into DefPropsStrings\n";
+print OUTFILE "};\n";
+print OUTFILE "\n";
+
+# Seeds of the buckets
+print OUTFILE "static const std::array<Int32, DEF_PROPS_SIZE> DefPropsSeeds = {{\n";
+for (my $i = 0; $i < $setsize; $i += 16)
 {
-  print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
+  my $end = $i + 15 < $setsize - 1 ? $i + 15 : $setsize - 1;
+  print OUTFILE "  " . join(", ", @seeds[$i .. $end]);
+  print OUTFILE "," if ($end < $setsize - 1);
+  print OUTFILE "\n";
+}
+print OUTFILE "}};\n";
+print OUTFILE "\n";
 
-  if ($idx+1 < $setsize) {
-    print OUTFILE ",";
-  }
+# Entries in slot order (plus an end marker)
+print OUTFILE "static const std::array<DefPropsEntry, DEF_PROPS_SIZE + 1> DefProps = {{\n";
+for (my $i = 0; $i < $setsize; $i++)
+{
+  my $key = $slots[$i];
+  print OUTFILE "  { 0x" . substr($key, 0, 16) . "ULL, 0x" . substr($key, 16, 16) .
+                "ULL, " . $first_field[$i] . " },\n";
+}
+print OUTFILE "  { 0, 0, " . $first_field[$setsize] . " }\n";
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+
+print OUTFILE "static const std::array<DefPropsField, DEF_PROPS_FIELDS> DefPropsFields = {{\n";
+for (my $i = 0; $i < $setsize; $i++)
+{
+  next if ($first_field[$i] == $first_field[$i+1]);
+  print OUTFILE "  " . join(", ", @fields[$first_field[$i] .. $first_field[$i+1]-1]);
+  print OUTFILE "," if ($first_field[$i+1] < @fields);
   print OUTFILE "\n";
-  $idx++;
 }
+print OUTFILE "}};\n";
+print OUTFILE "\n";
 
+print OUTFILE "static const std::array<const char*, DEF_PROPS_STRINGS> DefPropsStrings = {{\n";
+for (my $i = 0; $i < @strings; $i++)
+{
+  print OUTFILE "  \"$strings[$i]\"";
+  print OUTFILE "," if ($i + 1 < @strings);
+  print OUTFILE "\n";
+}
 print OUTFILE "}};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
@@ -90,6 +199,17 @@ print OUTFILE "#endif\n";
 close(OUTFILE);
 
 
+# 32-bit FNV-1a hash of the binary md5sum, starting with the given seed
+# NOTE: This must be kept in sync with PropertiesSet::defPropsSlot
+sub md5_hash {
+  my ($md5, $seed) = @_;
+  my $h = $seed == 0 ? 0x811c9dc5 : $seed;
+  for (my $i = 0; $i < 32; $i += 2) {
+    $h = (($h ^ hex(substr($md5, $i, 2))) * 0x01000193) & 0xffffffff;
+  }
+  return $h;
+}
+
 sub usage {
   print "create_props.pl <INPUT properties file> <OUTPUT C++ header>\n";
   print "\n";
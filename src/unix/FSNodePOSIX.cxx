@@ -180,6 +180,28 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode) con
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t FilesystemNodePOSIX::getSize() const
+{
+  struct stat st;
+  return _isFile && stat(_path.c_str(), &st) == 0 ? size_t(st.st_size) : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FilesystemNodePOSIX::getLastModified() const
+{
+  struct stat st;
+  if(!_isFile || stat(_path.c_str(), &st) != 0)
+    return 0;
+
+#if defined(__APPLE__)
+  const struct timespec& modified = st.st_mtimespec;
+#else
+  const struct timespec& modified = st.st_mtim;
+#endif
+  return uInt64(modified.tv_sec) * 1000000000 + uInt64(modified.tv_nsec);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodePOSIX::makeDir()
 {
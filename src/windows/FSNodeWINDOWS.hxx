@@ -67,6 +67,8 @@ class FilesystemNodeWINDOWS : public AbstractFSNode
     bool isFile() const override      { return _isFile;      }
     bool isReadable() const override;
     bool isWritable() const override;
+    size_t getSize() const override;
+    uInt64 getLastModified() const override;
     bool makeDir() override;
     bool rename(const string& newfile) override;
 
@@ -0,0 +1,121 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/**
+  Renders fixed frames with the Blargg NTSC filter (all presets, with and
+  without phosphor, single and multithreaded), and prints a hash of each
+  result.
+
+  'make regress' builds this with the vector code (SSE2 / NEON) and with
+  BSPF_NO_SIMD, and requires both builds to print the same hashes, i.e. the
+  vector code must be bit-exact.
+*/
+
+#include <cstdlib>
+
+#include "AtariNTSC.hxx"
+#include "PhosphorHandler.hxx"
+
+namespace {
+  constexpr uInt32 WIDTH = 160, HEIGHT = 240;
+
+  // A simple deterministic generator, so that all builds use the same input
+  class Random
+  {
+    public:
+      uInt32 next() { return myState = myState * 1664525 + 1013904223; }
+
+    private:
+      uInt32 myState{0x2B435044};
+  };
+
+  uInt64 hash(const vector<uInt32>& pixels)
+  {
+    // FNV-1a
+    uInt64 h = 0xcbf29ce484222325ULL;
+    for(uInt32 pixel: pixels)
+      for(int shift = 0; shift < 32; shift += 8)
+        h = (h ^ ((pixel >> shift) & 0xff)) * 0x100000001b3ULL;
+
+    return h;
+  }
+
+  // Random colors, vertical stripes (artifacts) and large uniform areas
+  vector<vector<uInt8>> createFrames()
+  {
+    vector<vector<uInt8>> frames(3, vector<uInt8>(WIDTH * HEIGHT));
+    Random random;
+
+    for(uInt32 i = 0; i < WIDTH * HEIGHT; ++i)
+    {
+      const uInt32 x = i % WIDTH, y = i / WIDTH;
+
+      frames[0][i] = uInt8(random.next() >> 24) & 0xfe;
+      frames[1][i] = (x & 1) ? uInt8(y) & 0xfe : 0x0e;
+      frames[2][i] = uInt8((x / 20) * 0x22 + (y / 30) * 0x10) & 0xfe;
+    }
+    return frames;
+  }
+}
+
+int main()
+{
+  const vector<vector<uInt8>> frames = createFrames();
+  const std::array<const AtariNTSC::Setup*, 4> presets = {
+    &AtariNTSC::TV_Composite, &AtariNTSC::TV_SVideo,
+    &AtariNTSC::TV_RGB, &AtariNTSC::TV_Bad
+  };
+  const std::array<const char*, 4> names = { "composite", "svideo", "rgb", "bad" };
+
+  PaletteArray palette;
+  Random random;
+  for(auto& color: palette)
+    color = random.next() & 0xffffff;
+
+  const uInt32 outWidth = AtariNTSC::outWidth(WIDTH);
+  vector<uInt32> out(outWidth * HEIGHT), phosphor(outWidth * HEIGHT);
+  PhosphorHandler handler;
+  handler.initialize(true, 60);
+
+  AtariNTSC ntsc;
+
+  for(uInt32 preset = 0; preset < presets.size(); ++preset)
+  {
+    ntsc.initialize(*presets[preset]);
+    ntsc.setPalette(palette);
+
+    for(uInt32 threads: { 1, 4 })
+    {
+      ntsc.enableThreading(threads > 1, threads);
+      std::fill(phosphor.begin(), phosphor.end(), 0);
+
+      for(uInt32 frame = 0; frame < frames.size(); ++frame)
+      {
+        ntsc.render(frames[frame].data(), WIDTH, HEIGHT, out.data(), outWidth * 4);
+        cout << names[preset] << " threads=" << threads << " frame=" << frame
+             << " " << std::hex << hash(out) << std::dec << endl;
+
+        ntsc.render(frames[frame].data(), WIDTH, HEIGHT, out.data(), outWidth * 4,
+                    phosphor.data());
+        cout << names[preset] << " threads=" << threads << " frame=" << frame
+             << " phosphor " << std::hex << hash(out) << std::dec << endl;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/**
+  Checks the phosphor blending of PhosphorHandler for all combinations of
+  current color, previous color and blend value (0-100%); run by
+  'make regress'.
+
+  - blendRow() (vector code, where available) must match getPixel() (the
+    lookup table) exactly, in all three channels.
+  - The lookup table must match the original one, which decayed the
+    previous color with a float multiplication, except for the differences
+    listed in 'ourAllowedDifferences'.
+*/
+
+#include <cstdlib>
+#include <map>
+
+#include "PhosphorHandler.hxx"
+
+namespace {
+  // The decay is now calculated in 16.16 fixed point, rounded up.  For these
+  // blend values, the float product of the original table was just below an
+  // integer for some previous colors, and was then truncated.  The blended
+  // channel is one step brighter than before for this number of (current,
+  // previous) pairs; all other values are unchanged.
+  const std::map<int, uInt32> ourAllowedDifferences = {
+    { 42,  63 },
+    { 52, 117 },
+    { 53, 159 },
+    { 59, 177 },
+    { 65, 117 },
+    { 78, 117 },
+    { 84, 189 }
+  };
+
+  // A blended channel of the original lookup table
+  uInt8 originalBlend(uInt8 current, uInt8 previous, int blend)
+  {
+    const float percent = blend / 100.F;
+    const uInt8 decayed = static_cast<uInt8>(previous * percent);
+
+    return current > decayed ? current : decayed;
+  }
+
+  // Compare the blended rows with the lookup table
+  uInt32 checkBlendRow(int blend)
+  {
+    std::array<uInt32, 256> current, previous, original, out;
+    uInt32 failures = 0;
+
+    for(uInt32 c = 0; c < 256; ++c)
+    {
+      // A different combination of the colors in each channel
+      for(uInt32 p = 0; p < 256; ++p)
+      {
+        current[p]  = (c << 16) | (p << 8) | (c ^ p);
+        previous[p] = (p << 16) | (c << 8) | (255 - p);
+      }
+      original = previous;
+
+      PhosphorHandler::blendRow(current.data(), previous.data(), out.data(),
+                                uInt32(out.size()));
+
+      for(uInt32 p = 0; p < 256; ++p)
+      {
+        const uInt32 expected = PhosphorHandler::getPixel(current[p], original[p]);
+
+        if(out[p] != expected || previous[p] != expected)
+        {
+          cerr << "blend " << blend << "%: blendRow() differs from getPixel() for "
+               << std::hex << current[p] << " / " << original[p] << std::dec
+               << endl;
+          ++failures;
+        }
+      }
+    }
+    return failures;
+  }
+
+  // Compare the lookup table with the original one
+  uInt32 checkTable(int blend)
+  {
+    uInt32 differences = 0, failures = 0;
+
+    for(uInt32 c = 0; c < 256; ++c)
+    {
+      for(uInt32 p = 0; p < 256; ++p)
+      {
+        const uInt8 blended = uInt8(PhosphorHandler::getPixel(c, p)),
+                    original = originalBlend(uInt8(c), uInt8(p), blend);
+
+        if(blended == original + 1)
+          ++differences;
+        else if(blended != original)
+        {
+          cerr << "blend " << blend << "%: " << c << " / " << p << " is "
+               << int(blended) << " instead of " << int(original) << endl;
+          ++failures;
+        }
+      }
+    }
+
+    const auto allowed = ourAllowedDifferences.find(blend);
+    const uInt32 expected =
+      allowed != ourAllowedDifferences.end() ? allowed->second : 0;
+
+    if(differences != expected)
+    {
+      cerr << "blend " << blend << "%: " << differences
+           << " pair(s) one step brighter than the original table, expected "
+           << expected << endl;
+      ++failures;
+    }
+    else if(differences > 0)
+      cout << "blend " << blend << "%: " << differences
+           << " pair(s) one step brighter than the original table (allowed)"
+           << endl;
+
+    return failures;
+  }
+}
+
+int main()
+{
+  PhosphorHandler handler;
+  uInt32 failures = 0;
+
+  for(int blend = 0; blend <= 100; ++blend)
+  {
+    // Force the table to be calculated again
+    handler.initialize(false, blend);
+    handler.initialize(true, blend);
+
+    failures += checkBlendRow(blend);
+    failures += checkTable(blend);
+  }
+
+  cout << (failures == 0 ? "ok" : "FAIL") << "    phosphor blend: "
+       << failures << " failure(s)" << endl;
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}